@@ -0,0 +1,10 @@
+#include "graph/bfs.hh"
+
+template auto bfs::execute(ForwardStarDigraph &g, NodeId source)
+    -> bfs_result;
+template auto bfs::execute(TransposedDigraph<ReverseStarDigraph> &g,
+                           NodeId source) -> bfs_result;
+template auto bfs::execute(FilteredStarDigraph<ForwardStarDigraph> &g,
+                           NodeId source) -> bfs_result;
+template auto bfs::execute(HybridStarDigraph<ForwardStarDigraph> &g,
+                           NodeId source) -> bfs_result;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "graph/bitset.hh"
+#include "graph/concepts.hh"
+#include "graph/filtered.hh"
+#include "graph/hybrid.hh"
+#include "graph/star.hh"
+#include "graph/visitor.hh"
+
+class bfs_entry {
+   public:
+    static constexpr uint32_t UNREACHED = std::numeric_limits<uint32_t>::max();
+
+    uint32_t distance = UNREACHED;
+    NodeId parent     = 0;
+};
+
+class bfs_result {
+   private:
+    std::vector<bfs_entry> ctl;
+
+   public:
+    bfs_result(size_t size_hint) : ctl(size_hint) {
+    }
+
+    auto begin() -> std::vector<bfs_entry>::iterator {
+        return ctl.begin();
+    }
+
+    auto end() -> std::vector<bfs_entry>::iterator {
+        return ctl.end();
+    }
+
+    auto at_v(NodeId i) -> bfs_entry & {
+        // Star representations guarantee that indexes always start at 1.
+        return ctl.at(i - 1);
+    }
+};
+
+class bfs {
+   public:
+    // See `prefetch_distance`; tuned with `representation-bench`.
+    static constexpr uint32_t DEFAULT_PREFETCH_DISTANCE = 8;
+
+    EdgeVisitor tree_edge_visitor     = NOOP_EDGE_VISITOR;
+    EdgeVisitor non_tree_edge_visitor = NOOP_EDGE_VISITOR;
+    VertexVisitor vertex_visitor      = NOOP_VERTEX_VISITOR;
+
+    // While visiting the successors of a vertex, the visited bit of the
+    // successor this many positions ahead is prefetched, and so is where the
+    // successors of the vertex this many positions ahead in the queue start. 0
+    // disables prefetching.
+    uint32_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE;
+
+    bfs() = default;
+
+    // Runs from `source` over any graph that can enumerate successors; each
+    // representation gets its own, fully inlined, instantiation.
+    template <OutNeighborGraph G>
+    auto execute(G &g, NodeId source) -> bfs_result {
+        if (source == 0 || source > vertex_count(g)) {
+            throw std::out_of_range("invalid source vertex");
+        }
+        bfs_result res(vertex_count(g));
+
+        // Every vertex is enqueued at most once, so a plain vector with a read
+        // cursor works as the queue (and keeps the frontier contiguous).
+        std::vector<NodeId> queue;
+        size_t head = 0;
+
+        // Whether a vertex was reached is checked for every arc, so it's kept
+        // in a bitset, which is much more likely to be in cache than the
+        // entries; these are only touched when their vertex is reached.
+        Bitset visited(vertex_count(g) + 1);
+
+        res.at_v(source).distance = 0;
+        visited.set(source);
+        queue.push_back(source);
+        while (head < queue.size()) {
+            const NodeId v        = queue[head++];
+            const uint32_t v_dist = res.at_v(v).distance;
+            vertex_visitor(v);
+            if (prefetch_distance != 0 &&
+                head + prefetch_distance - 1 < queue.size()) {
+                prefetch_neighbors(g, queue[head + prefetch_distance - 1]);
+            }
+
+            auto succs = out_neighbors(g, v);
+            auto ahead = succs.begin();
+            for (uint32_t i = 0; i < prefetch_distance && ahead != succs.end();
+                 i++, ++ahead) {
+                visited.prefetch(*ahead);
+            }
+            for (const NodeId succ_v : succs) {
+                if (prefetch_distance != 0 && ahead != succs.end()) {
+                    visited.prefetch(*ahead);
+                    ++ahead;
+                }
+                if (!visited.test_and_set(succ_v)) {
+                    tree_edge_visitor(v, succ_v);
+                    bfs_entry &succ_entry = res.at_v(succ_v);
+                    succ_entry.distance   = v_dist + 1;
+                    succ_entry.parent     = v;
+                    queue.push_back(succ_v);
+                } else {
+                    non_tree_edge_visitor(v, succ_v);
+                }
+            }
+        }
+
+        return res;
+    }
+};
+
+// The instantiations for the representations in this library are compiled
+// once, into the library itself.
+extern template auto bfs::execute(ForwardStarDigraph &g, NodeId source)
+    -> bfs_result;
+extern template auto bfs::execute(TransposedDigraph<ReverseStarDigraph> &g,
+                                  NodeId source) -> bfs_result;
+extern template auto bfs::execute(FilteredStarDigraph<ForwardStarDigraph> &g,
+                                  NodeId source) -> bfs_result;
+extern template auto bfs::execute(HybridStarDigraph<ForwardStarDigraph> &g,
+                                  NodeId source) -> bfs_result;
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "graph/star.hh"
+
+// A digraph that can enumerate both successors and predecessors, but only pays
+// for the latter once they are needed: the `ReverseStarDigraph` is built (with
+// `transpose`) by the first call that uses it, and kept from then on. Forward
+// only workloads cost as much as a plain `ForwardStarDigraph`.
+//
+// The reverse star is built exactly once, even if several threads ask for it
+// at the same time; afterwards, reading it takes no lock.
+class BidirectionalStarDigraph {
+   private:
+    ForwardStarDigraph fwd;
+    std::unique_ptr<ReverseStarDigraph> rev;
+    std::once_flag rev_once;
+
+   public:
+    BidirectionalStarDigraph(ForwardStarDigraph fwd) : fwd(std::move(fwd)) {
+    }
+
+    BidirectionalStarDigraph(uint32_t vertex_count, EdgeBag &edge_bag)
+        : fwd(vertex_count, edge_bag) {
+    }
+
+    // Returns the forward star.
+    auto forward() -> ForwardStarDigraph & {
+        return fwd;
+    }
+
+    // Returns the reverse star, building it if this is the first use.
+    auto reverse() -> ReverseStarDigraph & {
+        std::call_once(rev_once, [this] {
+            rev = std::make_unique<ReverseStarDigraph>(transpose(fwd));
+        });
+        return *rev;
+    }
+
+    // Returns whether the reverse star was already built. Not synchronized
+    // with `reverse`, so it's only meaningful when no other thread may be
+    // building it.
+    auto has_reverse() -> bool {
+        return rev != nullptr;
+    }
+
+    // Returns the number of vertexes in the graph.
+    auto vertexes_count() {
+        return fwd.vertexes_count();
+    }
+
+    // Returns an iterable over all the vertexes.
+    auto vertexes() {
+        return fwd.vertexes();
+    }
+
+    // Returns an iterable over the sucessor vertexes for the given vertex.
+    auto successors(uint32_t vertex) {
+        return fwd.successors(vertex);
+    }
+
+    // Returns the outdegree for the given vertex.
+    auto outdegree(uint32_t vertex) -> uint32_t {
+        return fwd.outdegree(vertex);
+    }
+
+    // Hints that the successors of the given vertex will be needed soon, so
+    // that where they start is fetched into the cache.
+    void prefetch(uint32_t vertex) {
+        fwd.prefetch(vertex);
+    }
+
+    // Returns the indegree and the outdegree of every vertex, without building
+    // the reverse star.
+    auto degree_arrays() -> vertex_degrees {
+        return fwd.degree_arrays();
+    }
+
+    // Returns whether the arc `orig -> dest` exists.
+    auto has_edge(uint32_t orig, uint32_t dest) -> bool {
+        return fwd.has_edge(orig, dest);
+    }
+
+    // Returns an iterable over the predecessor vertexes for the given vertex.
+    // Builds the reverse star on the first call.
+    auto predecessors(uint32_t vertex) {
+        return reverse().predecessors(vertex);
+    }
+
+    // Returns the indegree for the given vertex. Builds the reverse star on the
+    // first call.
+    auto indegree(uint32_t vertex) -> uint32_t {
+        return reverse().indegree(vertex);
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <bit>
+#include <vector>
+
+// A fixed-size set of bits, packed in 64-bit words.
+class Bitset {
+   private:
+    std::vector<uint64_t> words;
+    size_t bits;
+
+   public:
+    static constexpr size_t WORD_BITS = 64;
+
+    Bitset(size_t size, bool value = false)
+        : words((size + WORD_BITS - 1) / WORD_BITS, value ? ~0ULL : 0ULL),
+          bits(size) {
+        // keep the bits past the end cleared, so that `count` is exact
+        if (value && size % WORD_BITS != 0) {
+            words.back() >>= WORD_BITS - size % WORD_BITS;
+        }
+    }
+
+    [[nodiscard]] auto size() const -> size_t {
+        return bits;
+    }
+
+    [[nodiscard]] auto test(size_t i) const -> bool {
+        return ((words[i / WORD_BITS] >> (i % WORD_BITS)) & 1U) != 0U;
+    }
+
+    void set(size_t i) {
+        words[i / WORD_BITS] |= 1ULL << (i % WORD_BITS);
+    }
+
+    void reset(size_t i) {
+        words[i / WORD_BITS] &= ~(1ULL << (i % WORD_BITS));
+    }
+
+    // Sets the bit `i`, returning whether it was already set.
+    auto test_and_set(size_t i) -> bool {
+        uint64_t &word     = words[i / WORD_BITS];
+        const uint64_t bit = 1ULL << (i % WORD_BITS);
+        const bool was_set = (word & bit) != 0U;
+        word |= bit;
+        return was_set;
+    }
+
+    // Like `test_and_set`, but safe to call from several threads at once (as
+    // long as they only use the atomic operations on this bitset meanwhile):
+    // exactly one of the threads that set the same bit sees it unset.
+    auto atomic_test_and_set(size_t i) -> bool {
+        const uint64_t bit = 1ULL << (i % WORD_BITS);
+        std::atomic_ref<uint64_t> word(words[i / WORD_BITS]);
+        return (word.fetch_or(bit, std::memory_order_acq_rel) & bit) != 0U;
+    }
+
+    // Hints that the bit `i` will be needed soon.
+    void prefetch(size_t i) const {
+        __builtin_prefetch(words.data() + i / WORD_BITS);
+    }
+
+    [[nodiscard]] auto count() const -> size_t {
+        size_t total = 0;
+        for (const uint64_t w : words) total += std::popcount(w);
+        return total;
+    }
+
+    [[nodiscard]] auto words_count() const -> size_t {
+        return words.size();
+    }
+
+    [[nodiscard]] auto data() const -> const uint64_t * {
+        return words.data();
+    }
+};
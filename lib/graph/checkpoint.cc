@@ -0,0 +1,169 @@
+#include "graph/checkpoint.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+// The first bytes of every checkpoint file (the last one is the version).
+constexpr std::string_view CHECKPOINT_MAGIC = "DFSCKPT1";
+
+// The header is padded to this size, so that the slots are aligned.
+const size_t CHECKPOINT_HEADER_SIZE = 64;
+
+struct checkpoint_header {
+    char magic[CHECKPOINT_MAGIC.size()];
+    uint64_t vertexes;
+    // 0 if no state was saved yet, otherwise 1 + the index of the valid slot.
+    uint64_t valid_slot;
+};
+
+// A slot is this, followed by a `saved_entry` per vertex and then by room for
+// a `dfs_frame` per vertex.
+struct checkpoint_slot {
+    uint64_t time;
+    uint64_t root;
+    uint64_t depth;
+};
+
+// A `dfs_entry`, with a fixed layout.
+struct saved_entry {
+    uint64_t discovery_t;
+    uint64_t term_t;
+    uint32_t parent;
+    uint32_t unused;
+};
+
+auto dfs_checkpoint::slot_size() const -> size_t {
+    return sizeof(checkpoint_slot) +
+           vertexes * (sizeof(saved_entry) + sizeof(dfs_frame));
+}
+
+auto dfs_checkpoint::slot(uint64_t index) -> uint8_t * {
+    return map.data + CHECKPOINT_HEADER_SIZE + index * slot_size();
+}
+
+dfs_checkpoint::mapping::~mapping() {
+    if (data != nullptr) ::munmap(data, size);
+    if (fd >= 0) ::close(fd);
+}
+
+void dfs_checkpoint::mapping::open(const std::string &path, size_t bytes,
+                                   bool resume) {
+    const auto system_error = [&](const char *what) {
+        return std::system_error(errno, std::generic_category(),
+                                 what + (" `" + path + "`"));
+    };
+
+    // whatever is acquired is released by the destructor if this throws
+    fd = ::open(path.c_str(), resume ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC,
+                0644);
+    if (fd < 0) throw system_error("failed to open checkpoint");
+    if (resume) {
+        struct stat file {};
+        if (::fstat(fd, &file) != 0) {
+            throw system_error("failed to stat checkpoint");
+        }
+        if (static_cast<size_t>(file.st_size) != bytes) {
+            throw std::runtime_error("checkpoint `" + path +
+                                     "` is not for a graph of this size");
+        }
+    } else if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        throw system_error("failed to resize checkpoint");
+    }
+
+    void *addr =
+        ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) throw system_error("failed to map checkpoint");
+    data = static_cast<uint8_t *>(addr);
+    size = bytes;
+}
+
+dfs_checkpoint::dfs_checkpoint(const std::string &path, size_t vertexes,
+                               bool resume)
+    : vertexes(vertexes) {
+    map.open(path, CHECKPOINT_HEADER_SIZE + 2 * slot_size(), resume);
+
+    auto *header = reinterpret_cast<checkpoint_header *>(map.data);
+    if (!resume) {
+        std::memcpy(header->magic, CHECKPOINT_MAGIC.data(),
+                    CHECKPOINT_MAGIC.size());
+        header->vertexes   = vertexes;
+        header->valid_slot = 0;
+    } else if (std::string_view(header->magic, CHECKPOINT_MAGIC.size()) !=
+                   CHECKPOINT_MAGIC ||
+               header->vertexes != vertexes || header->valid_slot > 2) {
+        throw std::runtime_error("`" + path + "` is not a valid checkpoint");
+    }
+}
+
+auto dfs_checkpoint::has_state() -> bool {
+    return reinterpret_cast<checkpoint_header *>(map.data)->valid_slot != 0;
+}
+
+void dfs_checkpoint::save(const dfs_state &state) {
+    if (state.res.ctl.size() != vertexes || state.stack.size() > vertexes) {
+        throw std::invalid_argument("state is not for a graph of this size");
+    }
+    const auto sync = [this] {
+        if (::msync(map.data, map.size, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "failed to sync checkpoint");
+        }
+    };
+
+    auto *header         = reinterpret_cast<checkpoint_header *>(map.data);
+    const uint64_t index = header->valid_slot == 1 ? 1 : 0;
+    uint8_t *base        = slot(index);
+    auto *meta           = reinterpret_cast<checkpoint_slot *>(base);
+    auto *entries =
+        reinterpret_cast<saved_entry *>(base + sizeof(checkpoint_slot));
+    auto *frames = reinterpret_cast<dfs_frame *>(entries + vertexes);
+
+    meta->time  = state.time;
+    meta->root  = state.root;
+    meta->depth = state.stack.size();
+    for (size_t i = 0; i < vertexes; i++) {
+        const dfs_entry &e = state.res.ctl[i];
+        entries[i]         = {e.discovery_t, e.term_t, e.parent, 0};
+    }
+    std::copy(state.stack.begin(), state.stack.end(), frames);
+
+    // the new state must be on disk before it's made the valid one
+    sync();
+    header->valid_slot = index + 1;
+    sync();
+}
+
+auto dfs_checkpoint::load() -> dfs_state {
+    const auto *header = reinterpret_cast<checkpoint_header *>(map.data);
+    if (header->valid_slot == 0) {
+        throw std::runtime_error("checkpoint has no saved state");
+    }
+    const uint8_t *base = slot(header->valid_slot - 1);
+    const auto *meta    = reinterpret_cast<const checkpoint_slot *>(base);
+    const auto *entries =
+        reinterpret_cast<const saved_entry *>(base + sizeof(checkpoint_slot));
+    const auto *frames =
+        reinterpret_cast<const dfs_frame *>(entries + vertexes);
+    if (meta->depth > vertexes || meta->root > vertexes + 1) {
+        throw std::runtime_error("checkpoint is corrupted");
+    }
+
+    dfs_state state(vertexes);
+    state.time = meta->time;
+    state.root = meta->root;
+    for (size_t i = 0; i < vertexes; i++) {
+        const saved_entry &e = entries[i];
+        state.res.ctl[i]     = {e.discovery_t, e.term_t, e.parent};
+    }
+    state.stack.assign(frames, frames + meta->depth);
+    return state;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "graph/dfs.hh"
+
+// A file, mapped into memory, where a `dfs` saves its state from time to time
+// (see `dfs::checkpoint`), so that a long search that is interrupted can be
+// continued with `dfs::resume` instead of starting over.
+//
+// The file is sized upfront for the largest possible state (every vertex in
+// the stack), so saving never grows it. It has two slots for states and a
+// header that says which one is valid: a state is written to the other slot,
+// flushed to disk, and only then made the valid one, so a crash while saving
+// leaves the previous state intact.
+class dfs_checkpoint {
+   private:
+    // The mapped file, which is unmapped and closed when this is destroyed
+    // (even if it's by a throwing constructor).
+    struct mapping {
+        int fd        = -1;
+        uint8_t *data = nullptr;
+        size_t size   = 0;
+
+        mapping() = default;
+
+        mapping(const mapping &)                     = delete;
+        auto operator=(const mapping &) -> mapping & = delete;
+
+        ~mapping();
+
+        // Maps the file at `path`, read-write, with `bytes` bytes. Unless
+        // `resume`, the file is created (or emptied) with that size;
+        // otherwise, it must already have it.
+        void open(const std::string &path, size_t bytes, bool resume);
+    };
+
+    mapping map;
+    size_t vertexes = 0;
+
+    auto slot_size() const -> size_t;
+
+    auto slot(uint64_t index) -> uint8_t *;
+
+   public:
+    // Opens the checkpoint file at `path` for a search over a graph with
+    // `vertexes` vertexes. Unless `resume`, the file is created (or emptied);
+    // otherwise, it must hold a state saved for a graph of the same size.
+    // Throws `std::system_error` if the file can't be opened or mapped, and
+    // `std::runtime_error` if it can't be resumed from.
+    dfs_checkpoint(const std::string &path, size_t vertexes, bool resume);
+
+    dfs_checkpoint(const dfs_checkpoint &)                     = delete;
+    auto operator=(const dfs_checkpoint &) -> dfs_checkpoint & = delete;
+
+    // Returns whether a state was saved.
+    auto has_state() -> bool;
+
+    // Saves `state`, replacing the previous one once it's on disk.
+    void save(const dfs_state &state);
+
+    // Returns the last saved state. Throws `std::runtime_error` if there is
+    // none.
+    auto load() -> dfs_state;
+};
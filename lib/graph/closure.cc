@@ -0,0 +1,193 @@
+#include "graph/closure.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+#include "graph/parallel.hh"
+#include "graph/scc.hh"
+
+// Rows are made of words of this many bits, like a `Bitset`.
+const size_t WORD_BITS = Bitset::WORD_BITS;
+
+// The first bytes of every closure file (the last one is the version).
+constexpr std::string_view CLOSURE_MAGIC = "TCLOSUR1";
+
+// The header is padded to this size, so that what follows is aligned.
+const size_t CLOSURE_HEADER_SIZE = 64;
+
+struct closure_header {
+    char magic[CLOSURE_MAGIC.size()];
+    uint64_t vertexes;
+    uint64_t components;
+};
+
+// The size of a map for `vertexes` vertexes and `components` components: the
+// header, the component of each vertex (padded to a whole word) and the rows.
+static auto layout_size(size_t vertexes, size_t components) -> size_t {
+    const size_t component_bytes =
+        ((vertexes + 1) * sizeof(uint32_t) + 7) & ~size_t{7};
+    const size_t row_words = (components + WORD_BITS - 1) / WORD_BITS;
+    return CLOSURE_HEADER_SIZE + component_bytes +
+           components * row_words * sizeof(uint64_t);
+}
+
+// ORs `src` into `dst`. The loop is simple enough, and the rows are known not
+// to overlap, for the compiler to vectorize it, OR-ing several words at once.
+static void or_row(uint64_t *__restrict dst, const uint64_t *__restrict src,
+                   size_t words) {
+    for (size_t w = 0; w < words; w++) dst[w] |= src[w];
+}
+
+auto transitive_closure::bytes_for(size_t vertexes) -> size_t {
+    return layout_size(vertexes, vertexes);
+}
+
+transitive_closure::mapping::~mapping() {
+    if (data != nullptr) ::munmap(data, size);
+    if (fd >= 0) ::close(fd);
+}
+
+void transitive_closure::mapping::open(const std::string &path, size_t bytes,
+                                       bool create) {
+    const auto system_error = [&](const char *what) {
+        return std::system_error(errno, std::generic_category(),
+                                 what + (" `" + path + "`"));
+    };
+
+    if (path.empty()) {
+        void *addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "failed to map closure");
+        }
+        data = static_cast<uint8_t *>(addr);
+        size = bytes;
+        return;
+    }
+
+    // whatever is acquired is released by the destructor if this throws
+    fd = ::open(path.c_str(), create ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY,
+                0644);
+    if (fd < 0) throw system_error("failed to open closure");
+    if (create && ::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        throw system_error("failed to resize closure");
+    }
+    if (!create) {
+        struct stat file {};
+        if (::fstat(fd, &file) != 0) {
+            throw system_error("failed to stat closure");
+        }
+        bytes = file.st_size;
+        if (bytes < CLOSURE_HEADER_SIZE) {
+            throw std::runtime_error("`" + path + "` is not a valid closure");
+        }
+    }
+    const int prot = create ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *addr     = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) throw system_error("failed to map closure");
+    data = static_cast<uint8_t *>(addr);
+    size = bytes;
+}
+
+void transitive_closure::locate() {
+    row_words = (components + WORD_BITS - 1) / WORD_BITS;
+    component = reinterpret_cast<uint32_t *>(map.data + CLOSURE_HEADER_SIZE);
+    rows      = reinterpret_cast<uint64_t *>(
+        map.data + layout_size(vertexes, components) -
+        components * row_words * sizeof(uint64_t));
+}
+
+transitive_closure::transitive_closure(ForwardStarDigraph &g, size_t limit,
+                                       const std::string &path) {
+    vertexes = g.vertexes_count();
+    if (bytes_for(vertexes) > limit) {
+        throw std::length_error(
+            "closure may take " + std::to_string(bytes_for(vertexes)) +
+            " bytes, over the limit of " + std::to_string(limit));
+    }
+    const scc_result scc   = strongly_connected_components(g);
+    ForwardStarDigraph dag = condensation(g, scc);
+    components             = scc.count;
+
+    // fresh files and anonymous maps are zeroed
+    map.open(path, layout_size(vertexes, components), true);
+    locate();
+    auto *header = reinterpret_cast<closure_header *>(map.data);
+    std::memcpy(header->magic, CLOSURE_MAGIC.data(), CLOSURE_MAGIC.size());
+    header->vertexes   = vertexes;
+    header->components = components;
+    std::memcpy(component, scc.component.data(),
+                scc.component.size() * sizeof(uint32_t));
+
+    // Group the components by height (arcs go to higher numbered ones, so
+    // those are done first), counting sorted.
+    std::vector<uint32_t> height(components + 1, 0);
+    size_t max_height = 0;
+    for (size_t a = components; a >= 1; a--) {
+        for (const uint32_t b : dag.successors(a)) {
+            height[a] = std::max(height[a], height[b] + 1);
+        }
+        max_height = std::max<size_t>(max_height, height[a]);
+    }
+    std::vector<uint32_t> group_ptrs(max_height + 2, 0);
+    for (size_t a = 1; a <= components; a++) group_ptrs[height[a] + 1]++;
+    for (size_t h = 0; h <= max_height; h++) {
+        group_ptrs[h + 1] += group_ptrs[h];
+    }
+    std::vector<uint32_t> groups(components);
+    {
+        std::vector<uint32_t> cursor(group_ptrs.begin(), group_ptrs.end());
+        for (size_t a = 1; a <= components; a++) {
+            groups[cursor[height[a]]++] = a;
+        }
+    }
+
+    for (size_t h = 0; h <= max_height; h++) {
+        const uint32_t first = group_ptrs[h];
+        parallel_for(group_ptrs[h + 1] - first, [&](size_t begin, size_t end) {
+            for (size_t i = first + begin; i < first + end; i++) {
+                const uint32_t a = groups[i];
+                uint64_t *row    = rows + (a - 1) * row_words;
+                row[(a - 1) / WORD_BITS] |= 1ULL << ((a - 1) % WORD_BITS);
+                for (const uint32_t b : dag.successors(a)) {
+                    or_row(row, rows + (b - 1) * row_words, row_words);
+                }
+            }
+        });
+    }
+
+    if (map.fd >= 0 && ::msync(map.data, map.size, MS_SYNC) != 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "failed to sync closure `" + path + "`");
+    }
+}
+
+transitive_closure::transitive_closure(const std::string &path) {
+    const auto invalid = [&] {
+        return std::runtime_error("`" + path + "` is not a valid closure");
+    };
+
+    map.open(path, 0, false);
+    const auto *header = reinterpret_cast<const closure_header *>(map.data);
+    vertexes           = header->vertexes;
+    components         = header->components;
+    if (std::string_view(header->magic, CLOSURE_MAGIC.size()) !=
+            CLOSURE_MAGIC ||
+        components > vertexes || vertexes >= UINT32_MAX ||
+        layout_size(vertexes, components) != map.size) {
+        throw invalid();
+    }
+    locate();
+    for (size_t v = 1; v <= vertexes; v++) {
+        if (component[v] == 0 || component[v] > components) throw invalid();
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "graph/bitset.hh"
+#include "graph/star.hh"
+#include "graph/visitor.hh"
+
+// By default, closures that may take more than this many bytes are refused.
+const size_t DEFAULT_CLOSURE_LIMIT = 1ULL << 30U;
+
+// The reachability matrix of a digraph, answering "is there a path from `u`
+// to `v`?" in O(1). Every vertex reaches itself.
+//
+// Vertexes in the same strongly connected component reach the same ones, so
+// there is a bitset row per component (of the condensation) rather than per
+// vertex. The row of a component is its own bit OR-ed with the rows of its
+// successors, so rows are computed in reverse topological order: components
+// are grouped by their height (the longest path from them to a sink), and the
+// rows of each group are computed in parallel once the lower ones are done.
+//
+// The matrix lives in a memory map, either anonymous or of a file, which is
+// laid out as a header, the component of each vertex and the rows, so a
+// closure saved to a file can be opened and queried later without computing
+// it again.
+class transitive_closure {
+   private:
+    // A memory map, and the file behind it (if any), which are released when
+    // it's destroyed. Being a member, it is released even if the closure's
+    // constructor throws after mapping it.
+    struct mapping {
+        int fd        = -1;
+        uint8_t *data = nullptr;
+        size_t size   = 0;
+
+        mapping() = default;
+
+        mapping(const mapping &)                     = delete;
+        auto operator=(const mapping &) -> mapping & = delete;
+
+        ~mapping();
+
+        // Maps the file at `path`, which is created (or emptied) with
+        // `bytes` bytes if `create`, or else mapped whole, read-only. Maps
+        // `bytes` bytes of anonymous memory instead if `path` is empty.
+        void open(const std::string &path, size_t bytes, bool create);
+    };
+
+    mapping map;
+    size_t vertexes     = 0;
+    size_t components   = 0;
+    size_t row_words    = 0;
+    uint32_t *component = nullptr;
+    uint64_t *rows      = nullptr;
+
+    // Points `component` and `rows` into the map.
+    void locate();
+
+   public:
+    // Returns how many bytes the closure of a graph with `vertexes` vertexes
+    // may take, which is the size of the map when every component is a single
+    // vertex (about `vertexes^2 / 8`).
+    static auto bytes_for(size_t vertexes) -> size_t;
+
+    // Computes the closure of `g`, in a file at `path` (which is created, or
+    // emptied) or, if it's empty, in memory. Throws `std::length_error`,
+    // before doing anything, if `bytes_for` the graph is above `limit`, and
+    // `std::system_error` if the file can't be written.
+    transitive_closure(ForwardStarDigraph &g,
+                       size_t limit            = DEFAULT_CLOSURE_LIMIT,
+                       const std::string &path = "");
+
+    // Opens a closure saved at `path`, read-only. Throws `std::system_error`
+    // if the file can't be read, and `std::runtime_error` if it's not a
+    // closure.
+    explicit transitive_closure(const std::string &path);
+
+    transitive_closure(const transitive_closure &) = delete;
+    auto operator=(const transitive_closure &) -> transitive_closure & = delete;
+
+    auto vertexes_count() const -> size_t {
+        return vertexes;
+    }
+
+    auto components_count() const -> size_t {
+        return components;
+    }
+
+    // Returns the number of bytes actually taken by the matrix.
+    auto size_bytes() const -> size_t {
+        return map.size;
+    }
+
+    // Returns whether there is a path from `u` to `v`.
+    auto reaches(NodeId u, NodeId v) const -> bool {
+        if (u == 0 || v == 0 || u > vertexes || v > vertexes) {
+            throw std::out_of_range("invalid vertex");
+        }
+        const uint64_t *row = rows + (component[u] - 1) * row_words;
+        const uint32_t b    = component[v] - 1;
+        return ((row[b / Bitset::WORD_BITS] >> (b % Bitset::WORD_BITS)) & 1U) !=
+               0U;
+    }
+};
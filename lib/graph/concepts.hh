@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <concepts>
+
+// Customization points through which the traversal engines reach a graph. By
+// default they forward to the members every representation in this file has
+// (`vertexes_count`, `vertexes`, `successors` and `predecessors`); another
+// representation may either have those members or overload these functions
+// for its type (they are called unqualified, so ADL finds such overloads).
+// Being templates, calls through them are resolved and inlined at compile
+// time.
+
+template <typename G>
+constexpr auto vertex_count(G &g) -> size_t {
+    return g.vertexes_count();
+}
+
+template <typename G>
+constexpr auto all_vertexes(G &g) {
+    return g.vertexes();
+}
+
+template <typename G>
+constexpr auto out_neighbors(G &g, uint32_t vertex)
+    -> decltype(g.successors(vertex)) {
+    return g.successors(vertex);
+}
+
+template <typename G>
+constexpr auto in_neighbors(G &g, uint32_t vertex)
+    -> decltype(g.predecessors(vertex)) {
+    return g.predecessors(vertex);
+}
+
+// Returns whether `vertex` (an id in `1..vertex_count(g)`) is one of
+// `all_vertexes(g)`. Views that hide some ids say which ones they keep with a
+// `keeps_vertex` member; every other representation has them all. Lets an
+// engine that walks the ids in order (to save its position, for instance)
+// skip hidden ones without going through `all_vertexes(g)`.
+template <typename G>
+constexpr auto contains_vertex(G &g, uint32_t vertex) -> bool {
+    if constexpr (requires { g.keeps_vertex(vertex); }) {
+        return g.keeps_vertex(vertex);
+    } else {
+        return true;
+    }
+}
+
+// Hints that the neighbors of `vertex` will soon be enumerated, so that the
+// representation may fetch where they start into the cache. Representations
+// without a `prefetch` member don't prefetch anything.
+template <typename G>
+void prefetch_neighbors(G &g, uint32_t vertex) {
+    if constexpr (requires { g.prefetch(vertex); }) g.prefetch(vertex);
+}
+
+// A graph whose vertexes are `1..vertex_count(g)`, iterable with
+// `all_vertexes(g)`.
+template <typename G>
+concept VertexGraph = requires(G &g) {
+    { vertex_count(g) } -> std::convertible_to<size_t>;
+    { *all_vertexes(g).begin() } -> std::convertible_to<uint32_t>;
+    all_vertexes(g).end();
+};
+
+// A graph that can enumerate the successors of a vertex.
+template <typename G>
+concept OutNeighborGraph = VertexGraph<G> && requires(G &g, uint32_t v) {
+    { *out_neighbors(g, v).begin() } -> std::convertible_to<uint32_t>;
+    out_neighbors(g, v).end();
+};
+
+// A graph that can enumerate the predecessors of a vertex.
+template <typename G>
+concept InNeighborGraph = VertexGraph<G> && requires(G &g, uint32_t v) {
+    { *in_neighbors(g, v).begin() } -> std::convertible_to<uint32_t>;
+    in_neighbors(g, v).end();
+};
+
+// The transpose of `G`, without copying it: successors are `G`'s predecessors
+// (and the other way around, when `G` has successors). Passing a
+// `ReverseStarDigraph` through it lets the engines traverse arcs backwards.
+template <InNeighborGraph G>
+class TransposedDigraph {
+   private:
+    G &g;
+
+   public:
+    TransposedDigraph(G &g) : g(g) {
+    }
+
+    auto vertexes_count() -> size_t {
+        return vertex_count(g);
+    }
+
+    auto vertexes() {
+        return all_vertexes(g);
+    }
+
+    auto keeps_vertex(uint32_t vertex) -> bool {
+        return contains_vertex(g, vertex);
+    }
+
+    auto successors(uint32_t vertex) {
+        return in_neighbors(g, vertex);
+    }
+
+    auto predecessors(uint32_t vertex)
+        requires OutNeighborGraph<G>
+    {
+        return out_neighbors(g, vertex);
+    }
+
+    void prefetch(uint32_t vertex) {
+        prefetch_neighbors(g, vertex);
+    }
+};
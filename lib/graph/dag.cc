@@ -0,0 +1,173 @@
+#include "graph/dag.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+#include "graph/bitset.hh"
+#include "graph/parallel.hh"
+#include "graph/scc.hh"
+
+// Raises `target` to `value`, if it's larger, atomically.
+template <typename T>
+static void atomic_max(T &target, T value) {
+    std::atomic_ref<T> ref(target);
+    T current = ref.load(std::memory_order_relaxed);
+    while (current < value &&
+           !ref.compare_exchange_weak(current, value,
+                                      std::memory_order_relaxed)) {
+    }
+}
+
+auto critical_path(ForwardStarDigraph &g, const std::vector<uint64_t> *weights)
+    -> critical_path_result {
+    const auto ptrs  = g.neighbor_offsets();
+    const auto edges = g.neighbor_array();
+    const size_t n   = ptrs.size() - 2;
+    if (weights != nullptr && weights->size() < edges.size()) {
+        throw std::invalid_argument("weights are too few");
+    }
+    const auto weight = [&](size_t e) -> uint64_t {
+        return weights == nullptr ? 1 : (*weights)[e];
+    };
+
+    critical_path_result res;
+    res.earliest_start.assign(n + 1, 0);
+    res.parent.assign(n + 1, 0);
+    std::vector<uint64_t> &start  = res.earliest_start;
+    std::vector<uint32_t> pending = count_indegrees(n, edges);
+
+    std::vector<NodeId> level;
+    for (NodeId v = 1; v <= n; v++) {
+        if (pending[v] == 0) level.push_back(v);
+    }
+    size_t done = 0;
+    std::vector<NodeId> next;
+    std::mutex next_mutex;
+    while (!level.empty()) {
+        res.levels++;
+        done += level.size();
+        next.clear();
+        parallel_for(level.size(), [&](size_t begin, size_t end) {
+            std::vector<NodeId> local;
+            for (size_t i = begin; i < end; i++) {
+                const NodeId u = level[i];
+                for (uint32_t e = ptrs[u]; e < ptrs[u + 1]; e++) {
+                    const NodeId v = edges[e];
+                    atomic_max(start[v], start[u] + weight(e));
+                    // the last predecessor to finish sees every other one's
+                    // update to `start[v]`
+                    std::atomic_ref<uint32_t> left(pending[v]);
+                    if (left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        local.push_back(v);
+                    }
+                }
+            }
+            const std::lock_guard lock(next_mutex);
+            next.insert(next.end(), local.begin(), local.end());
+        });
+        level.swap(next);
+    }
+    if (done != n) throw std::invalid_argument("graph has a cycle");
+
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (NodeId u = begin + 1; u <= end; u++) {
+            for (uint32_t e = ptrs[u]; e < ptrs[u + 1]; e++) {
+                const NodeId v = edges[e];
+                if (start[u] + weight(e) == start[v]) {
+                    atomic_max(res.parent[v], u);
+                }
+            }
+        }
+    });
+
+    if (n == 0) return res;
+    NodeId last =
+        std::max_element(start.begin() + 1, start.end()) - start.begin();
+    res.length = start[last];
+    for (; last != 0; last = res.parent[last]) {
+        res.critical_path.push_back(last);
+    }
+    std::reverse(res.critical_path.begin(), res.critical_path.end());
+    return res;
+}
+
+auto transitive_reduction(ForwardStarDigraph &g) -> ForwardStarDigraph {
+    return transitive_reduction(g, strongly_connected_components(g));
+}
+
+auto transitive_reduction(ForwardStarDigraph &g, const scc_result &scc)
+    -> ForwardStarDigraph {
+    const size_t n         = g.vertexes_count();
+    ForwardStarDigraph dag = condensation(g, scc);
+    const size_t c         = scc.count;
+    const auto ptrs        = dag.neighbor_offsets();
+    const auto edges       = dag.neighbor_array();
+    const size_t WORD_BITS = Bitset::WORD_BITS;
+
+    // the widest chunk, in whole words, whose sets fit in the budget
+    const size_t chunk_words = std::max<size_t>(
+        1, REDUCTION_CHUNK_BYTES / sizeof(uint64_t) / std::max<size_t>(c, 1));
+    Bitset redundant(edges.size());
+    std::vector<uint64_t> reach;
+    for (size_t lo = 1; lo <= c; lo += chunk_words * WORD_BITS) {
+        const size_t hi    = std::min(lo + chunk_words * WORD_BITS, c + 1);
+        const size_t words = (hi - lo + WORD_BITS - 1) / WORD_BITS;
+        // `reach[a * words..]` has the components in `[lo, hi)` reachable
+        // from `a`, which must be before `hi`
+        reach.assign(hi * words, 0);
+        const auto bit_of = [&](size_t b) -> uint64_t {
+            return 1ULL << ((b - lo) % WORD_BITS);
+        };
+        const auto or_into = [&](uint64_t *dst, size_t b) {
+            const uint64_t *src = reach.data() + b * words;
+            for (size_t w = 0; w < words; w++) dst[w] |= src[w];
+        };
+        for (size_t a = hi - 1; a >= 1; a--) {
+            uint64_t *set = reach.data() + a * words;
+            for (uint32_t e = ptrs[a]; e < ptrs[a + 1] && edges[e] < hi; e++) {
+                const size_t b = edges[e];
+                or_into(set, b);
+                if (b >= lo) set[(b - lo) / WORD_BITS] |= bit_of(b);
+            }
+        }
+
+        parallel_for(hi - 1, [&](size_t begin, size_t end) {
+            std::vector<uint64_t> covered(words);
+            for (size_t a = begin + 1; a <= end; a++) {
+                std::fill(covered.begin(), covered.end(), 0);
+                for (uint32_t e = ptrs[a]; e < ptrs[a + 1] && edges[e] < hi;
+                     e++) {
+                    const size_t b = edges[e];
+                    if (b >= lo &&
+                        (covered[(b - lo) / WORD_BITS] & bit_of(b)) != 0U) {
+                        // arcs of other threads' vertexes may share the word
+                        redundant.atomic_test_and_set(e);
+                    }
+                    or_into(covered.data(), b);
+                }
+            }
+        });
+    }
+
+    // the first vertex of each component stands for it
+    std::vector<uint32_t> first(c + 1, 0);
+    for (uint32_t v = n; v >= 1; v--) first[scc.component[v]] = v;
+    // chain the vertexes of each component in order, and then close the cycle
+    std::vector<uint32_t> last(c + 1, 0);
+    EdgeBag edge_bag(0);
+    for (uint32_t v = 1; v <= n; v++) {
+        const uint32_t a = scc.component[v];
+        if (last[a] != 0) edge_bag.add(Edge(last[a], v));
+        last[a] = v;
+    }
+    for (size_t a = 1; a <= c; a++) {
+        if (last[a] != first[a]) edge_bag.add(Edge(last[a], first[a]));
+        for (uint32_t e = ptrs[a]; e < ptrs[a + 1]; e++) {
+            if (redundant.test(e)) continue;
+            edge_bag.add(Edge(first[a], first[edges[e]]));
+        }
+    }
+    return {static_cast<uint32_t>(n), edge_bag};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "graph/scc.hh"
+#include "graph/star.hh"
+#include "graph/visitor.hh"
+
+struct critical_path_result {
+    // The length of the longest path ending at each vertex, which, if arcs
+    // are the durations between dependent jobs, is the earliest time it can
+    // start. Indexed by vertex (the first element is unused).
+    std::vector<uint64_t> earliest_start;
+    // The vertex before each one on a longest path ending at it (the largest
+    // one, if there are several), or 0 for those without predecessors.
+    std::vector<NodeId> parent;
+    // A longest path of the whole graph, ending at the first vertex with the
+    // largest earliest start, and its length.
+    std::vector<NodeId> critical_path;
+    uint64_t length = 0;
+    // The number of levels: vertexes without predecessors are in the first
+    // one, and every other vertex is in the level after its last predecessor.
+    size_t levels = 0;
+};
+
+// Finds the longest paths of the DAG `g`, with the length of each arc taken
+// from `weights`, indexed by the position of the arc in `g`'s `edges` (like
+// `FilteredStarDigraph`'s edge mask), or 1 if it's null. Throws if `g` has a
+// cycle.
+//
+// Works level by level, in topological order (Kahn's algorithm): the vertexes
+// of a level are relaxed in parallel, pushing their earliest start to their
+// successors with an atomic max, and a successor joins the next level when
+// its last predecessor is done (that is, when its shared indegree counter
+// drops to 0). A final parallel pass over the arcs finds the parents. Takes
+// O(V + E) work, with as much parallelism as the levels are wide.
+auto critical_path(ForwardStarDigraph &g,
+                   const std::vector<uint64_t> *weights = nullptr)
+    -> critical_path_result;
+
+// Bounds the memory taken by the reachability sets of `transitive_reduction`.
+const size_t REDUCTION_CHUNK_BYTES = 1U << 28U;
+
+// Returns the graph with the fewest arcs, on the same vertexes, with the same
+// reachability as `g`. Self-loops are dropped.
+//
+// The strongly connected components are condensed into a DAG, numbered in
+// topological order. There, an arc `a -> b` is implied by a longer path if
+// `b` is reachable from a successor of `a` before it (arcs only go forwards
+// in that order, so later successors can't reach it). The reachability sets
+// are bitsets over the components, computed back to front. To keep their
+// memory within `REDUCTION_CHUNK_BYTES`, they are restricted to one chunk
+// of components at a time, and only the arcs into that chunk are checked
+// (in parallel over the vertexes). Checking takes O(E * C / 64) word
+// operations in total, for `C` components.
+//
+// Each component then gets back one arc for each kept arc of the DAG, from
+// its first vertex to the first vertex of the other one, and, if it has more
+// than one vertex, a cycle through all of them.
+auto transitive_reduction(ForwardStarDigraph &g) -> ForwardStarDigraph;
+
+// Like `transitive_reduction(g)`, with the strongly connected components of
+// `g` already computed, for callers that need them too.
+auto transitive_reduction(ForwardStarDigraph &g, const scc_result &scc)
+    -> ForwardStarDigraph;
@@ -0,0 +1,140 @@
+#include "graph/dfs.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "graph/checkpoint.hh"
+
+auto operator<<(std::ostream &sink, const digraph_edge_classification &ec)
+    -> std::ostream & {
+    switch (ec) {
+        case digraph_edge_classification::tree:
+            sink << "tree";
+            break;
+        case digraph_edge_classification::back:
+            sink << "back";
+            break;
+        case digraph_edge_classification::forward:
+            sink << "forward";
+            break;
+        case digraph_edge_classification::cross:
+            sink << "cross";
+            break;
+    }
+    return sink;
+}
+
+auto dfs_result::classify_edge(NodeId orig, NodeId dest)
+    -> digraph_edge_classification {
+    auto &orig_e = at_v(orig);
+    auto &dest_e = at_v(dest);
+
+    if (orig_e.discovery_t < dest_e.discovery_t) {
+        if (dest_e.parent == orig) {
+            return digraph_edge_classification::tree;
+        }
+        return digraph_edge_classification::forward;
+    }
+
+    if (dest_e.term_t < orig_e.discovery_t) {
+        return digraph_edge_classification::forward;
+    }
+    return digraph_edge_classification::back;
+}
+
+void dfs_result::index_discovery_order() {
+    // Discovery times are below `2 * V + 1`, so they are counting sorted.
+    const size_t n = ctl.size();
+    std::vector<NodeId> by_time(2 * n + 1, 0);
+    for (NodeId v = 1; v <= n; v++) {
+        if (at_v(v).discovery_t != 0U) by_time[at_v(v).discovery_t] = v;
+    }
+    discovery_order.clear();
+    discovery_rank.assign(n + 1, 0);
+    for (const NodeId v : by_time) {
+        if (v == 0) continue;
+        discovery_rank[v] = discovery_order.size();
+        discovery_order.push_back(v);
+    }
+}
+
+auto dfs_result::path_to(NodeId vertex) -> std::vector<NodeId> {
+    std::vector<NodeId> path;
+    if (at_v(vertex).discovery_t == 0U) return path;
+    for (NodeId v = vertex; v != 0; v = at_v(v).parent) path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+auto dfs_result::subtree_of(NodeId vertex) -> std::span<const NodeId> {
+    const dfs_entry &entry = at_v(vertex);
+    if (entry.discovery_t == 0U) return {};
+    if (entry.term_t == 0U) {
+        throw std::logic_error("vertex is not finished");
+    }
+    if (discovery_rank.empty()) index_discovery_order();
+    return {discovery_order.data() + discovery_rank[vertex],
+            (entry.term_t - entry.discovery_t + 1) / 2};
+}
+
+auto dfs_result::forest() -> ForwardStarDigraph {
+    const size_t n = ctl.size();
+    if (discovery_rank.empty()) index_discovery_order();
+
+    // count the children of each vertex (shifted by one, so that the scan is
+    // in-place), and then write them in discovery order
+    std::vector<uint32_t> ptrs(n + 2, 0);
+    for (const NodeId v : discovery_order) {
+        if (at_v(v).parent != 0) ptrs[at_v(v).parent + 1]++;
+    }
+    ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t v = 1; v <= n; v++) ptrs[v + 1] += ptrs[v];
+
+    std::vector<uint32_t> edges(ptrs[n + 1]);
+    edges[0] = 0;
+    std::vector<uint32_t> cursor(ptrs.begin(), ptrs.end() - 1);
+    for (const NodeId v : discovery_order) {
+        if (at_v(v).parent != 0) edges[cursor[at_v(v).parent]++] = v;
+    }
+    return {std::move(ptrs), std::move(edges), false};
+}
+
+auto dfs::load_checkpoint(size_t vertexes) -> dfs_state {
+    if (checkpoint == nullptr) {
+        throw std::logic_error("there is no checkpoint to resume from");
+    }
+    dfs_state state = checkpoint->load();
+    if (static_cast<size_t>(std::distance(state.res.begin(),
+                                          state.res.end())) != vertexes) {
+        throw std::runtime_error("checkpoint is not for a graph of this size");
+    }
+    return state;
+}
+
+void dfs::save_checkpoint(const dfs_state &state) {
+    checkpoint->save(state);
+}
+
+template auto dfs::execute(ForwardStarDigraph &g) -> dfs_result;
+template auto dfs::execute(TransposedDigraph<ReverseStarDigraph> &g)
+    -> dfs_result;
+template auto dfs::execute(FilteredStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
+template auto dfs::execute(HybridStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
+template auto dfs::execute(ForwardStarDigraph &g, NodeId source)
+    -> dfs_result;
+template auto dfs::execute(TransposedDigraph<ReverseStarDigraph> &g,
+                           NodeId source) -> dfs_result;
+template auto dfs::execute(FilteredStarDigraph<ForwardStarDigraph> &g,
+                           NodeId source) -> dfs_result;
+template auto dfs::execute(HybridStarDigraph<ForwardStarDigraph> &g,
+                           NodeId source) -> dfs_result;
+template auto dfs::resume(ForwardStarDigraph &g) -> dfs_result;
+template auto dfs::resume(TransposedDigraph<ReverseStarDigraph> &g)
+    -> dfs_result;
+template auto dfs::resume(FilteredStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
+template auto dfs::resume(HybridStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
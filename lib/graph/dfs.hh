@@ -0,0 +1,364 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph/bitset.hh"
+#include "graph/concepts.hh"
+#include "graph/filtered.hh"
+#include "graph/hybrid.hh"
+#include "graph/star.hh"
+#include "graph/visitor.hh"
+
+enum class digraph_edge_classification : uint8_t {
+    tree,
+    back,
+    forward,
+    cross,
+};
+
+auto operator<<(std::ostream &sink, const digraph_edge_classification &ec)
+    -> std::ostream &;
+
+class dfs_entry {
+   public:
+    size_t discovery_t = 0;
+    size_t term_t      = 0;
+    NodeId parent      = 0;
+};
+
+class dfs_checkpoint;
+
+class dfs_result {
+    friend class dfs_checkpoint;
+    friend class lca_index;
+
+   private:
+    std::vector<dfs_entry> ctl;
+    // The discovered vertexes, in discovery order, and the position of each
+    // one in it (meaningless for the undiscovered ones). Built on demand, by
+    // `index_discovery_order`.
+    std::vector<NodeId> discovery_order;
+    std::vector<uint32_t> discovery_rank;
+
+    void index_discovery_order();
+
+   public:
+    dfs_result(size_t size_hint) : ctl(size_hint) {
+    }
+
+    auto begin() -> std::vector<dfs_entry>::iterator {
+        return ctl.begin();
+    }
+
+    auto end() -> std::vector<dfs_entry>::iterator {
+        return ctl.end();
+    }
+
+    auto at_v(NodeId i) -> dfs_entry & {
+        // Since we're using the forward star representation to implement this
+        // algorithm, there is a guarantee that indexes always start at 1.
+        return ctl.at(i - 1);
+    }
+
+    auto classify_edge(NodeId orig, NodeId dest)
+        -> digraph_edge_classification;
+
+    // Returns the tree path from the root of the tree holding `vertex` to it,
+    // following parents, or nothing if it's undiscovered. Takes time linear
+    // in the length of the path.
+    auto path_to(NodeId vertex) -> std::vector<NodeId>;
+
+    // Returns `vertex` and its descendants in the DFS forest, in discovery
+    // order, or nothing if it's undiscovered. Throws if `vertex` isn't
+    // finished (as after a stopped search).
+    //
+    // Each vertex takes two ticks of the clock, when it's discovered and when
+    // it's finished, and the ticks between those of `vertex` are exactly the
+    // ones of its descendants. So they are the `(term_t - discovery_t + 1) /
+    // 2` vertexes starting at `vertex` in discovery order, and, once that
+    // order is built (in O(V), on the first call, from the entries as they
+    // are then), each call takes time linear in the size of the subtree.
+    auto subtree_of(NodeId vertex) -> std::span<const NodeId>;
+
+    // Returns the DFS forest as a graph, with an arc from each vertex to each
+    // of its children, which are listed in discovery order. Takes O(V).
+    auto forest() -> ForwardStarDigraph;
+};
+
+// A frame of the DFS stack: a vertex and how many of its successors were
+// already visited.
+struct dfs_frame {
+    NodeId vertex;
+    uint32_t cursor;
+};
+
+// Everything needed to continue a DFS: the result so far, the time counter,
+// the root of the tree being built (or the next vertex to try as a root, if
+// the stack is empty) and the stack.
+struct dfs_state {
+    dfs_result res;
+    uint64_t time = 0;
+    NodeId root   = 1;
+    std::vector<dfs_frame> stack;
+
+    dfs_state(size_t vertexes) : res(vertexes) {
+    }
+};
+
+class dfs {
+   public:
+    // By default, a checkpoint is saved every this many visited arcs. Saving
+    // copies the whole state, so the interval should be large enough for that
+    // to be amortized.
+    static constexpr uint64_t DEFAULT_CHECKPOINT_INTERVAL = 1ULL << 26U;
+    // See `prefetch_distance`; tuned with `representation-bench`.
+    static constexpr uint32_t DEFAULT_PREFETCH_DISTANCE = 8;
+
+    // Visitors may steer the search with what they return:
+    //  - `stop` ends it right away, leaving the vertexes still on the stack
+    //    unfinished (with `term_t` 0), so a search that finds what it wants
+    //    early only costs as much as what it explored;
+    //  - `skip_subtree`, from `vertex_visitor(v)`, finishes `v` without
+    //    visiting its successors, and, from `tree_edge_visitor(v, w)`, does
+    //    the same for `w` (which is still discovered, and passed to
+    //    `vertex_visitor`). From the other visitors, it's the same as
+    //    `proceed`.
+    // Visitors returning nothing always proceed.
+    ControlEdgeVisitor tree_edge_visitor    = NOOP_EDGE_VISITOR;
+    ControlEdgeVisitor back_edge_visitor    = NOOP_EDGE_VISITOR;
+    ControlEdgeVisitor forward_edge_visitor = NOOP_EDGE_VISITOR;
+    ControlEdgeVisitor cross_edge_visitor   = NOOP_EDGE_VISITOR;
+    ControlVertexVisitor vertex_visitor     = NOOP_VERTEX_VISITOR;
+
+    // When set, the state of the search is saved to it every
+    // `checkpoint_interval` visited arcs and once it's done, so that a search
+    // that is interrupted may be continued with `resume`.
+    dfs_checkpoint *checkpoint   = nullptr;
+    uint64_t checkpoint_interval = DEFAULT_CHECKPOINT_INTERVAL;
+
+    // While visiting the successors of a vertex, the visited bit of the
+    // successor this many positions ahead (and where its own successors start)
+    // is prefetched, so that its cache misses overlap with the work on the
+    // current one. 0 disables prefetching.
+    uint32_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE;
+
+    dfs() = default;
+
+    // Runs over any graph that can enumerate successors; each representation
+    // gets its own, fully inlined, instantiation.
+    template <OutNeighborGraph G>
+    auto execute(G &g) -> dfs_result {
+        dfs_state state(vertex_count(g));
+        return run(g, state, vertex_count(g));
+    }
+
+    // Like `execute(g)`, but only searches from `source`, so that only the
+    // vertexes it reaches are discovered. Can't be checkpointed.
+    template <OutNeighborGraph G>
+    auto execute(G &g, NodeId source) -> dfs_result {
+        if (source == 0 || source > vertex_count(g) ||
+            !contains_vertex(g, source)) {
+            throw std::out_of_range("invalid source vertex");
+        }
+        if (checkpoint != nullptr) {
+            throw std::logic_error("a search from a source can't be saved");
+        }
+        dfs_state state(vertex_count(g));
+        state.root = source;
+        return run(g, state, source);
+    }
+
+    // Continues the search saved in `checkpoint` (which must have been made
+    // over the same graph), giving the same result as an uninterrupted run.
+    // Visitors are only called for what happens after the checkpoint.
+    template <OutNeighborGraph G>
+    auto resume(G &g) -> dfs_result {
+        dfs_state state = load_checkpoint(vertex_count(g));
+        return run(g, state, vertex_count(g));
+    }
+
+   private:
+    auto load_checkpoint(size_t vertexes) -> dfs_state;
+
+    void save_checkpoint(const dfs_state &state);
+
+    // Runs the search in `state` up to (and including) the tree rooted at
+    // `last_root`.
+    template <OutNeighborGraph G>
+    auto run(G &g, dfs_state &state, NodeId last_root) -> dfs_result {
+        using iterator = decltype(out_neighbors(g, NodeId{1}).begin());
+
+        // Each frame keeps the iterator to its next successor, so that, once
+        // a child is finished, its parent resumes right after it (instead of
+        // scanning its successors again from the beginning), and the one to
+        // the next successor to prefetch.
+        struct frame {
+            NodeId vertex;
+            uint32_t cursor;
+            iterator next;
+            iterator end;
+            iterator ahead;
+        };
+
+        dfs_result &res = state.res;
+        uint64_t &time  = state.time;
+        const size_t n  = vertex_count(g);
+        std::vector<frame> st;
+
+        // Whether a vertex was discovered is checked for every arc, so it's
+        // kept in a bitset, which is much more likely to be in cache than the
+        // entries (a bit against 24 bytes per vertex). Entries are only
+        // touched when their vertex is discovered or finished, or to classify
+        // non-tree arcs, which is skipped if no visitor wants them.
+        Bitset visited(n + 1);
+        if (time != 0) {
+            for (NodeId v = 1; v <= n; v++) {
+                if (res.at_v(v).discovery_t != 0U) visited.set(v);
+            }
+        }
+        const bool classify = !back_edge_visitor.empty() ||
+                              !forward_edge_visitor.empty() ||
+                              !cross_edge_visitor.empty();
+
+        const auto prefetch = [&](NodeId v) {
+            visited.prefetch(v);
+            prefetch_neighbors(g, v);
+        };
+        const auto push = [&](NodeId v, uint32_t cursor) {
+            auto succs = out_neighbors(g, v);
+            auto next  = succs.begin();
+            std::advance(next, cursor);
+            frame f{v, cursor, next, succs.end(), next};
+            for (uint32_t i = 0; i < prefetch_distance && f.ahead != f.end;
+                 i++, ++f.ahead) {
+                prefetch(*f.ahead);
+            }
+            st.push_back(f);
+        };
+        for (const dfs_frame &f : state.stack) push(f.vertex, f.cursor);
+
+        // Discovers `v`, which is reached from `parent` (0 for a root), and
+        // either pushes it or, if `skip` or the vertex visitor says so,
+        // finishes it right away. Returns whether the search must stop.
+        const auto discover = [&](NodeId v, NodeId parent, bool skip) {
+            dfs_entry &entry            = res.at_v(v);
+            entry.parent                = parent;
+            entry.discovery_t           = ++time;
+            const visit_control control = vertex_visitor(v);
+            if (control == visit_control::stop) return true;
+            if (skip || control == visit_control::skip_subtree) {
+                entry.term_t = ++time;
+            } else {
+                push(v, 0);
+            }
+            return false;
+        };
+
+        uint64_t until_checkpoint = checkpoint_interval;
+        // Roots are tried in id order, rather than through `all_vertexes(g)`,
+        // so that the next one to try can be saved in a checkpoint; ids the
+        // graph hides are skipped.
+        for (NodeId &root = state.root; root <= last_root; root++) {
+            if (st.empty()) {
+                if (!contains_vertex(g, root)) continue;
+                // Skip if we find a vertex which is already discovered.
+                if (visited.test_and_set(root)) continue;
+                if (discover(root, 0, false)) return std::move(res);
+            }
+
+            while (!st.empty()) {
+                frame &f = st.back();
+                if (f.next == f.end) {
+                    res.at_v(f.vertex).term_t = ++time;
+                    st.pop_back();
+                    continue;
+                }
+                const NodeId v      = f.vertex;
+                const NodeId succ_v = *f.next;
+                ++f.next;
+                f.cursor++;
+                if (prefetch_distance != 0 && f.ahead != f.end) {
+                    prefetch(*f.ahead);
+                    ++f.ahead;
+                }
+
+                // We have just discovered `succ_v`.
+                visit_control control = visit_control::proceed;
+                if (!visited.test_and_set(succ_v)) {
+                    control = tree_edge_visitor(v, succ_v);
+                    if (control != visit_control::stop &&
+                        discover(succ_v, v,
+                                 control == visit_control::skip_subtree)) {
+                        control = visit_control::stop;
+                    }
+                } else if (classify) {
+                    const dfs_entry &v_entry    = res.at_v(v);
+                    const dfs_entry &succ_entry = res.at_v(succ_v);
+                    // The dest `succ_v` is ancestral and isn't yet finished.
+                    if (succ_entry.term_t == 0) {
+                        control = back_edge_visitor(v, succ_v);
+                    }
+                    // The origin `v` is discovered before the dest `succ_v`.
+                    else if (v_entry.discovery_t < succ_entry.discovery_t) {
+                        control = forward_edge_visitor(v, succ_v);
+                    }
+                    // The origin `v` is discovered after the dest `succ_v`.
+                    else {
+                        control = cross_edge_visitor(v, succ_v);
+                    }
+                }
+                // A stopped search isn't saved, so `resume` continues from
+                // the last checkpoint.
+                if (control == visit_control::stop) return std::move(res);
+
+                if (checkpoint != nullptr && --until_checkpoint == 0) {
+                    state.stack.clear();
+                    for (const frame &sf : st) {
+                        state.stack.push_back({sf.vertex, sf.cursor});
+                    }
+                    save_checkpoint(state);
+                    until_checkpoint = checkpoint_interval;
+                }
+            }
+        }
+
+        if (checkpoint != nullptr) {
+            state.stack.clear();
+            save_checkpoint(state);
+        }
+        return std::move(res);
+    }
+};
+
+// The instantiations for the representations in this library are compiled
+// once, into the library itself.
+extern template auto dfs::execute(ForwardStarDigraph &g) -> dfs_result;
+extern template auto dfs::execute(TransposedDigraph<ReverseStarDigraph> &g)
+    -> dfs_result;
+extern template auto dfs::execute(FilteredStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
+extern template auto dfs::execute(HybridStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
+extern template auto dfs::execute(ForwardStarDigraph &g, NodeId source)
+    -> dfs_result;
+extern template auto dfs::execute(TransposedDigraph<ReverseStarDigraph> &g,
+                                  NodeId source) -> dfs_result;
+extern template auto dfs::execute(FilteredStarDigraph<ForwardStarDigraph> &g,
+                                  NodeId source) -> dfs_result;
+extern template auto dfs::execute(HybridStarDigraph<ForwardStarDigraph> &g,
+                                  NodeId source) -> dfs_result;
+extern template auto dfs::resume(ForwardStarDigraph &g) -> dfs_result;
+extern template auto dfs::resume(TransposedDigraph<ReverseStarDigraph> &g)
+    -> dfs_result;
+extern template auto dfs::resume(FilteredStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
+extern template auto dfs::resume(HybridStarDigraph<ForwardStarDigraph> &g)
+    -> dfs_result;
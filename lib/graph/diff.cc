@@ -0,0 +1,286 @@
+#include "graph/diff.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "graph/parallel.hh"
+
+// The first bytes of every delta file (the last two are the format version).
+constexpr std::string_view DELTA_MAGIC = "GDELTA01";
+
+// Walks the sorted ranges `[a, a_end)` and `[b, b_end)` together, calling
+// `only_a(elem)` for each element that is only in the first one and
+// `only_b(elem)` for each one that is only in the second one.
+template <typename OnlyA, typename OnlyB>
+static void diff_sorted(const uint32_t *a, const uint32_t *a_end,
+                        const uint32_t *b, const uint32_t *b_end,
+                        OnlyA only_a, OnlyB only_b) {
+    while (a != a_end || b != b_end) {
+        if (b == b_end || (a != a_end && *a < *b)) {
+            only_a(*a++);
+        } else if (a == a_end || *b < *a) {
+            only_b(*b++);
+        } else {
+            a++;
+            b++;
+        }
+    }
+}
+
+// Turns `lists.ptrs`, which holds the size of each list shifted by one, into
+// the actual pointers, and allocates `lists.edges` for them.
+static void finish_ptrs(arc_lists &lists) {
+    const size_t n = lists.ptrs.size() - 2;
+    lists.ptrs[1]  = 1;  // first element of `edges` is unused
+    for (size_t v = 1; v <= n; v++) lists.ptrs[v + 1] += lists.ptrs[v];
+    lists.edges.resize(lists.ptrs[n + 1]);
+    lists.edges[0] = 0;
+}
+
+auto diff(ForwardStarDigraph &old_g, ForwardStarDigraph &new_g)
+    -> graph_delta {
+    if (!old_g.is_sorted() || !new_g.is_sorted()) {
+        throw std::logic_error("diff requires sorted neighbor lists");
+    }
+    graph_delta delta;
+    delta.old_vertexes = old_g.vertexes_count();
+    delta.new_vertexes = new_g.vertexes_count();
+    const size_t n     = std::max(delta.old_vertexes, delta.new_vertexes);
+    const auto list_of = [](ForwardStarDigraph &g, size_t v)
+        -> std::pair<const uint32_t *, const uint32_t *> {
+        const auto ptrs  = g.neighbor_offsets();
+        const auto edges = g.neighbor_array();
+        if (v + 2 > ptrs.size()) return {nullptr, nullptr};
+        return {edges.data() + ptrs[v], edges.data() + ptrs[v + 1]};
+    };
+    const auto diff_of = [&](size_t v, auto on_removed, auto on_added) {
+        const auto [a, a_end] = list_of(old_g, v);
+        const auto [b, b_end] = list_of(new_g, v);
+        diff_sorted(a, a_end, b, b_end, on_removed, on_added);
+    };
+
+    arc_lists &added   = delta.added;
+    arc_lists &removed = delta.removed;
+    added.ptrs.assign(n + 2, 0);
+    removed.ptrs.assign(n + 2, 0);
+
+    // first pass: count (shifted by one, so that the scan is in-place)
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            uint32_t added_count   = 0;
+            uint32_t removed_count = 0;
+            diff_of(
+                v, [&](uint32_t) { removed_count++; },
+                [&](uint32_t) { added_count++; });
+            added.ptrs[v + 1]   = added_count;
+            removed.ptrs[v + 1] = removed_count;
+        }
+    });
+    finish_ptrs(added);
+    finish_ptrs(removed);
+
+    // second pass: write
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            uint32_t *added_out   = added.edges.data() + added.ptrs[v];
+            uint32_t *removed_out = removed.edges.data() + removed.ptrs[v];
+            diff_of(
+                v, [&](uint32_t dest) { *removed_out++ = dest; },
+                [&](uint32_t dest) { *added_out++ = dest; });
+        }
+    });
+    return delta;
+}
+
+auto apply(ForwardStarDigraph &g, const graph_delta &delta)
+    -> ForwardStarDigraph {
+    const auto g_ptrs  = g.neighbor_offsets();
+    const auto g_edges = g.neighbor_array();
+    const size_t n     = delta.new_vertexes;
+    const size_t delta_size =
+        std::max(delta.old_vertexes, delta.new_vertexes) + 2;
+    if (g_ptrs.size() - 2 != delta.old_vertexes ||
+        delta.added.ptrs.size() != delta_size ||
+        delta.removed.ptrs.size() != delta_size) {
+        throw std::invalid_argument("delta does not match the graph's size");
+    }
+    if (!g.is_sorted()) {
+        throw std::logic_error("apply requires sorted neighbor lists");
+    }
+
+    // The vertexes past the new ones are dropped, so their deltas must add
+    // nothing and remove every old successor; otherwise the delta was taken
+    // against another graph.
+    for (size_t v = n + 1; v + 2 <= delta_size; v++) {
+        const auto removed = delta.removed.of(v);
+        const uint32_t *old_lo =
+            g_edges.data() + (v <= delta.old_vertexes ? g_ptrs[v] : 0);
+        const uint32_t *old_hi =
+            g_edges.data() + (v <= delta.old_vertexes ? g_ptrs[v + 1] : 0);
+        if (!delta.added.of(v).empty() ||
+            !std::equal(removed.begin(), removed.end(), old_lo, old_hi)) {
+            throw std::invalid_argument(
+                "delta does not match the graph's arcs");
+        }
+    }
+
+    // Writes, with `out(i, dest)`, the new successors of `v`: the old ones
+    // that were not removed, merged with the added ones.
+    std::atomic<bool> mismatch = false;
+    const auto apply_of = [&](size_t v, auto out) {
+        // vertexes past the old ones start without successors
+        const uint32_t old_lo   = v <= delta.old_vertexes ? g_ptrs[v] : 0;
+        const uint32_t old_hi   = v <= delta.old_vertexes ? g_ptrs[v + 1] : 0;
+        const auto added        = delta.added.of(v);
+        const auto removed      = delta.removed.of(v);
+        const uint32_t *add     = added.data();
+        const uint32_t *add_end = added.data() + added.size();
+        uint32_t count          = 0;
+        diff_sorted(
+            g_edges.data() + old_lo, g_edges.data() + old_hi, removed.data(),
+            removed.data() + removed.size(),
+            [&](uint32_t dest) {
+                while (add != add_end && *add < dest) out(count++, *add++);
+                out(count++, dest);
+            },
+            [&](uint32_t) { mismatch = true; });
+        while (add != add_end) out(count++, *add++);
+        return count;
+    };
+
+    std::vector<uint32_t> ptrs(n + 2, 0);
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            ptrs[v + 1] = apply_of(v, [&](uint32_t, uint32_t dest) {
+                if (dest == 0U || dest > n) mismatch = true;
+            });
+        }
+    });
+    if (mismatch) {
+        throw std::invalid_argument("delta does not match the graph's arcs");
+    }
+    ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t v = 1; v <= n; v++) ptrs[v + 1] += ptrs[v];
+
+    std::vector<uint32_t> edges(ptrs[n + 1]);
+    edges[0] = 0;
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            uint32_t *out = edges.data() + ptrs[v];
+            apply_of(v, [out](uint32_t i, uint32_t dest) { out[i] = dest; });
+        }
+    });
+    return {std::move(ptrs), std::move(edges), true};
+}
+
+static void write_varint(std::ostream &sink, uint64_t value) {
+    while (value >= 0x80U) {
+        sink.put(static_cast<char>((value & 0x7FU) | 0x80U));
+        value >>= 7U;
+    }
+    sink.put(static_cast<char>(value));
+}
+
+static auto read_varint(std::istream &source) -> uint64_t {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        const int byte = source.get();
+        if (byte == std::istream::traits_type::eof()) {
+            throw std::runtime_error("truncated delta");
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return value;
+    }
+    throw std::runtime_error("malformed delta (varint is too long)");
+}
+
+// Reads a varint that must be in `[lo, hi]`.
+static auto read_varint_in(std::istream &source, uint64_t lo, uint64_t hi)
+    -> uint32_t {
+    const uint64_t value = read_varint(source);
+    if (value < lo || value > hi) {
+        throw std::runtime_error("malformed delta (value out of range)");
+    }
+    return value;
+}
+
+void write_delta(std::ostream &sink, const graph_delta &delta) {
+    const size_t n     = delta.added.ptrs.size() - 2;
+    const auto changed = [&](size_t v) {
+        return !delta.added.of(v).empty() || !delta.removed.of(v).empty();
+    };
+    const auto write_gaps = [&](std::span<const uint32_t> dests) {
+        uint32_t prev = 0;
+        for (const uint32_t dest : dests) {
+            write_varint(sink, dest - prev);
+            prev = dest;
+        }
+    };
+
+    sink.write(DELTA_MAGIC.data(), DELTA_MAGIC.size());
+    write_varint(sink, delta.old_vertexes);
+    write_varint(sink, delta.new_vertexes);
+    size_t changed_count = 0;
+    for (size_t v = 1; v <= n; v++) changed_count += changed(v) ? 1 : 0;
+    write_varint(sink, changed_count);
+
+    size_t prev = 0;
+    for (size_t v = 1; v <= n; v++) {
+        if (!changed(v)) continue;
+        write_varint(sink, v - prev);
+        prev = v;
+        write_varint(sink, delta.added.of(v).size());
+        write_varint(sink, delta.removed.of(v).size());
+        write_gaps(delta.added.of(v));
+        write_gaps(delta.removed.of(v));
+    }
+}
+
+auto read_delta(std::istream &source) -> graph_delta {
+    char magic[DELTA_MAGIC.size()];
+    if (!source.read(magic, sizeof(magic)) ||
+        std::string_view(magic, sizeof(magic)) != DELTA_MAGIC) {
+        throw std::runtime_error("not a delta file");
+    }
+
+    graph_delta delta;
+    delta.old_vertexes = read_varint_in(source, 0, UINT32_MAX);
+    delta.new_vertexes = read_varint_in(source, 0, UINT32_MAX);
+    const size_t n     = std::max(delta.old_vertexes, delta.new_vertexes);
+    delta.added.ptrs.assign(n + 2, 0);
+    delta.removed.ptrs.assign(n + 2, 0);
+    delta.added.edges.push_back(0);
+    delta.removed.edges.push_back(0);
+
+    // Appends `count` gap-encoded dests, which must be in `1..max_dest`.
+    const auto read_gaps = [&](std::vector<uint32_t> &edges, uint32_t count,
+                               uint32_t max_dest) {
+        uint32_t prev = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            prev += read_varint_in(source, i == 0 ? 1 : 0, max_dest - prev);
+            edges.push_back(prev);
+        }
+    };
+
+    const size_t changed_count = read_varint_in(source, 0, n);
+    size_t v                   = 0;
+    for (size_t i = 0; i < changed_count; i++) {
+        v += read_varint_in(source, 1, n - v);
+        const uint32_t added_count   = read_varint_in(source, 0, UINT32_MAX);
+        const uint32_t removed_count = read_varint_in(source, 0, UINT32_MAX);
+        read_gaps(delta.added.edges, added_count, delta.new_vertexes);
+        read_gaps(delta.removed.edges, removed_count, delta.old_vertexes);
+        delta.added.ptrs[v + 1]   = added_count;
+        delta.removed.ptrs[v + 1] = removed_count;
+    }
+    delta.added.ptrs[1]   = 1;
+    delta.removed.ptrs[1] = 1;
+    for (size_t u = 1; u <= n; u++) {
+        delta.added.ptrs[u + 1] += delta.added.ptrs[u];
+        delta.removed.ptrs[u + 1] += delta.removed.ptrs[u];
+    }
+    return delta;
+}
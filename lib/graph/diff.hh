@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "graph/star.hh"
+
+// Arcs grouped by their origin, laid out like a star: the dests of the arcs
+// leaving `v` are `edges[ptrs[v]..ptrs[v + 1]]`, in sorted order. As usual,
+// the first element of both arrays is unused.
+struct arc_lists {
+    std::vector<uint32_t> ptrs;
+    std::vector<uint32_t> edges;
+
+    // Returns the dests of the arcs leaving `vertex`.
+    [[nodiscard]] auto of(uint32_t vertex) const -> std::span<const uint32_t> {
+        return {edges.data() + ptrs[vertex], ptrs[vertex + 1] - ptrs[vertex]};
+    }
+
+    // Returns the total number of arcs.
+    [[nodiscard]] auto arcs_count() const -> size_t {
+        return edges.size() - 1;
+    }
+};
+
+// The arcs that must be added to and removed from one snapshot of a graph to
+// get another one. Vertexes are `1..max(old_vertexes, new_vertexes)`; the
+// vertexes past `new_vertexes` are dropped, so every arc touching them is in
+// `removed`.
+struct graph_delta {
+    uint32_t old_vertexes = 0;
+    uint32_t new_vertexes = 0;
+    arc_lists added;
+    arc_lists removed;
+};
+
+// Computes the delta from the snapshot `old_g` to the snapshot `new_g`, which
+// must have sorted successor lists. Both lists of each vertex are merged, in
+// two parallel passes over the vertexes (as in `symmetrize`): the first one
+// counts the arcs that are only in one of them and the second one writes them.
+// A repeated arc counts as many times as it appears.
+auto diff(ForwardStarDigraph &old_g, ForwardStarDigraph &new_g)
+    -> graph_delta;
+
+// Applies `delta` to `g`, which must be the snapshot it was computed from,
+// returning the other one. Works in two parallel passes over the vertexes,
+// like `diff`. Throws if `g` has a different vertex count or lacks an arc
+// that `delta` removes.
+auto apply(ForwardStarDigraph &g, const graph_delta &delta)
+    -> ForwardStarDigraph;
+
+// Writes `delta` in a compact binary format: a header, then, for each vertex
+// with changes, the gap from the previous such vertex, the number of added and
+// removed arcs, and their dests, each one as the gap from the previous dest.
+// Every number is a LEB128 varint, so sparse deltas over large graphs take a
+// few bytes per changed arc.
+void write_delta(std::ostream &sink, const graph_delta &delta);
+
+// Reads a delta written by `write_delta`. Throws if the input is malformed.
+auto read_delta(std::istream &source) -> graph_delta;
@@ -0,0 +1,88 @@
+#include "graph/dominators.hh"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "graph/concepts.hh"
+#include "graph/dfs.hh"
+
+// Marks preorder numbers that don't exist: the ones of unreachable vertexes
+// and the ancestors of roots in the compression forest.
+static const uint32_t NONE = UINT32_MAX;
+
+auto immediate_dominators(ForwardStarDigraph &fwd, ReverseStarDigraph &rev,
+                          NodeId entry) -> std::vector<NodeId> {
+    const size_t n = fwd.vertexes_count();
+    if (rev.vertexes_count() != n) {
+        throw std::invalid_argument("graphs have different vertex counts");
+    }
+    if (entry == 0 || entry > n) {
+        throw std::out_of_range("invalid entry vertex");
+    }
+
+    // Number the reachable vertexes in preorder. From here on, everything is
+    // indexed by those numbers, so that the arrays are dense.
+    std::vector<NodeId> order;
+    std::vector<uint32_t> pre(n + 1, NONE);
+    dfs dfs_executor;
+    dfs_executor.vertex_visitor = [&](NodeId v) {
+        pre[v] = order.size();
+        order.push_back(v);
+    };
+    dfs_result res  = dfs_executor.execute(fwd, entry);
+    const size_t m  = order.size();
+    std::vector<uint32_t> parent(m, NONE);
+    for (size_t i = 1; i < m; i++) parent[i] = pre[res.at_v(order[i]).parent];
+
+    // `ancestor` links each processed vertex to its DFS parent, and `label`
+    // is the vertex with the lowest semidominator on the path (compressed by
+    // `eval`) from it up to the root of its tree in that forest, excluded.
+    std::vector<uint32_t> semi(m);
+    std::vector<uint32_t> label(m);
+    std::vector<uint32_t> ancestor(m, NONE);
+    for (size_t i = 0; i < m; i++) semi[i] = label[i] = i;
+
+    std::vector<uint32_t> path;
+    const auto eval = [&](uint32_t v) -> uint32_t {
+        if (ancestor[v] == NONE) return v;
+        // Compress the path from `v`, from its top down (iteratively, since
+        // it can be as long as the graph is deep).
+        for (uint32_t u = v; ancestor[ancestor[u]] != NONE; u = ancestor[u]) {
+            path.push_back(u);
+        }
+        while (!path.empty()) {
+            const uint32_t u = path.back();
+            const uint32_t a = ancestor[u];
+            path.pop_back();
+            if (semi[label[a]] < semi[label[u]]) label[u] = label[a];
+            ancestor[u] = ancestor[a];
+        }
+        return label[v];
+    };
+
+    for (size_t i = m - 1; i >= 1; i--) {
+        uint32_t s = parent[i];
+        for (const NodeId p : in_neighbors(rev, order[i])) {
+            if (pre[p] == NONE) continue;  // unreachable predecessor
+            s = std::min(s, semi[eval(pre[p])]);
+        }
+        semi[i]     = s;
+        ancestor[i] = parent[i];
+    }
+
+    // The nearest common ancestor of each vertex's parent and semidominator
+    // is its immediate dominator; parents are done before their children.
+    std::vector<uint32_t> idom(parent);
+    for (size_t i = 1; i < m; i++) {
+        uint32_t d = idom[i];
+        while (d > semi[i]) d = idom[d];
+        idom[i] = d;
+    }
+
+    std::vector<NodeId> result(n + 1, 0);
+    result[entry] = entry;
+    for (size_t i = 1; i < m; i++) result[order[i]] = order[idom[i]];
+    return result;
+}
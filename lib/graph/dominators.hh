@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "graph/star.hh"
+#include "graph/visitor.hh"
+
+// Computes the immediate dominator of every vertex reachable from `entry`: the
+// closest vertex (other than itself) through which every path from `entry` to
+// it passes. `fwd` and `rev` must hold the same arcs. Returns an array indexed
+// by vertex (whose first element is unused), with `entry` for `entry` itself
+// and 0 for the unreachable vertexes. Following it from any vertex walks up
+// the dominator tree.
+//
+// It's the semi-NCA algorithm: a DFS from `entry` numbers the vertexes in
+// preorder; the semidominator of each one is found, in reverse preorder, as
+// the lowest numbered vertex from which it can be reached by a path whose
+// inner vertexes are all numbered above it, looking at its predecessors in
+// `rev` through a forest with path compression; then, in preorder, the
+// immediate dominator of each vertex is its nearest ancestor, in the DFS tree,
+// that is not numbered above its semidominator. Takes O(E log V) time in the
+// worst case and is near-linear in practice, with O(V) extra memory.
+auto immediate_dominators(ForwardStarDigraph &fwd, ReverseStarDigraph &rev,
+                          NodeId entry) -> std::vector<NodeId>;
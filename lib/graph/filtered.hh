@@ -0,0 +1,197 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+
+#include "graph/bitset.hh"
+#include "graph/star.hh"
+
+// Iterates over the neighbors, in a star's `edges`, whose arc and vertex are
+// not masked out.
+class FilteredNeighborsIterable {
+    template <typename G>
+    friend class FilteredStarDigraph;
+
+   public:
+    class iterator {
+        friend class FilteredNeighborsIterable;
+
+       private:
+        const uint32_t *edges;
+        const Bitset *vertex_mask;
+        const Bitset *edge_mask;
+        uint32_t pos;
+        uint32_t end;
+
+        iterator(const uint32_t *edges, const Bitset *vertex_mask,
+                 const Bitset *edge_mask, uint32_t pos, uint32_t end)
+            : edges(edges),
+              vertex_mask(vertex_mask),
+              edge_mask(edge_mask),
+              pos(pos),
+              end(end) {
+            skip_masked();
+        }
+
+        void skip_masked() {
+            while (pos < end &&
+                   ((edge_mask != nullptr && !edge_mask->test(pos)) ||
+                    (vertex_mask != nullptr && !vertex_mask->test(edges[pos]))))
+                pos++;
+        }
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = uint32_t;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const uint32_t *;
+        using reference         = const uint32_t &;
+
+        iterator() = default;
+
+        auto operator*() const -> const uint32_t & {
+            return edges[pos];
+        }
+
+        auto operator++() -> iterator & {
+            pos++;
+            skip_masked();
+            return *this;
+        }
+
+        auto operator++(int) -> iterator {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        auto operator==(const iterator &other) const -> bool {
+            return pos == other.pos;
+        }
+
+        // Position of the current arc in the underlying star's `edges`.
+        [[nodiscard]] auto edge_index() const -> uint32_t {
+            return pos;
+        }
+    };
+
+   private:
+    iterator _begin;
+    iterator _end;
+
+    FilteredNeighborsIterable(const uint32_t *edges, const Bitset *vertex_mask,
+                              const Bitset *edge_mask, uint32_t start,
+                              uint32_t end)
+        : _begin(edges, vertex_mask, edge_mask, start, end),
+          _end(edges, vertex_mask, edge_mask, end, end) {
+    }
+
+   public:
+    auto begin() {
+        return _begin;
+    }
+
+    auto end() {
+        return _end;
+    }
+};
+
+// A zero-copy view over the star digraph `G` that hides masked-out vertexes
+// and arcs. `vertex_mask` is indexed by vertex id (bit 0 is unused) and
+// `edge_mask` by the position of the arc in `G`'s `edges`, so that it lines up
+// with any per-arc data (such as labels or weights). A cleared bit hides the
+// vertex, with all of its arcs, or the arc. Either mask may be null, in which
+// case nothing is filtered by it. The masks are borrowed, not copied.
+template <typename G>
+class FilteredStarDigraph {
+   private:
+    G &g;
+    const Bitset *vertex_mask;
+    const Bitset *edge_mask;
+
+    auto neighbors(uint32_t vertex) -> FilteredNeighborsIterable {
+        const auto ptrs = g.neighbor_offsets();
+        if (vertex + 1 >= ptrs.size()) {
+            throw std::out_of_range("invalid vertex");
+        }
+        if (!keeps_vertex(vertex)) {
+            return {nullptr, nullptr, nullptr, 0, 0};
+        }
+        return {g.neighbor_array().data(), vertex_mask, edge_mask,
+                ptrs[vertex], ptrs[vertex + 1]};
+    }
+
+   public:
+    FilteredStarDigraph(G &g, const Bitset *vertex_mask,
+                        const Bitset *edge_mask)
+        : g(g), vertex_mask(vertex_mask), edge_mask(edge_mask) {
+        if (vertex_mask != nullptr &&
+            vertex_mask->size() < g.neighbor_offsets().size() - 1) {
+            throw std::invalid_argument("vertex mask is too small");
+        }
+        if (edge_mask != nullptr &&
+            edge_mask->size() < g.neighbor_array().size()) {
+            throw std::invalid_argument("edge mask is too small");
+        }
+    }
+
+    // Builds an edge mask for `g` with the arcs for which `pred(vertex,
+    // neighbor, edge_index)` holds.
+    template <typename F>
+    static auto edge_mask_where(G &g, F pred) -> Bitset {
+        const auto ptrs  = g.neighbor_offsets();
+        const auto edges = g.neighbor_array();
+        Bitset mask(edges.size());
+        for (const uint32_t v : g.vertexes()) {
+            for (uint32_t e = ptrs[v]; e < ptrs[v + 1]; e++) {
+                if (pred(v, edges[e], e)) mask.set(e);
+            }
+        }
+        return mask;
+    }
+
+    // Returns whether the given vertex is visible in this view.
+    auto keeps_vertex(uint32_t vertex) const -> bool {
+        return vertex_mask == nullptr || vertex_mask->test(vertex);
+    }
+
+    // Returns the number of vertexes in the underlying graph. Hidden vertexes
+    // keep their ids, so this is still the size for any per-vertex array.
+    auto vertexes_count() {
+        return g.vertexes_count();
+    }
+
+    // Returns an iterable over all the visible vertexes.
+    auto vertexes() {
+        return g.vertexes() | std::views::filter([this](uint32_t v) {
+                   return keeps_vertex(v);
+               });
+    }
+
+    // Returns an iterable over the visible sucessor vertexes for the given
+    // vertex.
+    auto successors(uint32_t vertex) -> FilteredNeighborsIterable
+        requires std::same_as<G, ForwardStarDigraph>
+    {
+        return neighbors(vertex);
+    }
+
+    // Returns an iterable over the visible predecessor vertexes for the given
+    // vertex.
+    auto predecessors(uint32_t vertex) -> FilteredNeighborsIterable
+        requires std::same_as<G, ReverseStarDigraph>
+    {
+        return neighbors(vertex);
+    }
+
+    // Hints that the neighbors of the given vertex will be needed soon, so
+    // that where they start is fetched into the cache.
+    void prefetch(uint32_t vertex) {
+        g.prefetch(vertex);
+    }
+};
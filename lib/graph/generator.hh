@@ -0,0 +1,151 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+// A lazily computed sequence of `T`s, produced by a coroutine that returns it
+// and `co_yield`s each element. Nothing runs until the sequence is iterated,
+// and then only up to the element being read, so a consumer that stops early
+// (or destroys the generator) stops the coroutine right there.
+//
+// The coroutine's frame, which holds all of its state, is allocated once, when
+// it's called; each element is handed out by address and lives in that frame
+// until the coroutine is resumed, so yielding never allocates. It's a
+// move-only, single-pass view, like C++23's `std::generator` (which isn't
+// available in C++20).
+template <typename T>
+class generator : public std::ranges::view_base {
+   public:
+    class promise_type {
+        friend class generator;
+
+       private:
+        const T *current = nullptr;
+        std::exception_ptr error;
+
+       public:
+        auto get_return_object() -> generator {
+            return generator(handle::from_promise(*this));
+        }
+
+        auto initial_suspend() noexcept -> std::suspend_always {
+            return {};
+        }
+
+        auto final_suspend() noexcept -> std::suspend_always {
+            return {};
+        }
+
+        // The element is a temporary (or a local) of the coroutine, which is
+        // kept alive while it's suspended here.
+        auto yield_value(const T &value) noexcept -> std::suspend_always {
+            current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            error = std::current_exception();
+        }
+
+        // Generators only yield; awaiting anything inside them is an error.
+        template <typename U>
+        auto await_transform(U &&) -> std::suspend_never = delete;
+    };
+
+   private:
+    using handle = std::coroutine_handle<promise_type>;
+
+    handle coro;
+
+    explicit generator(handle coro) : coro(coro) {
+    }
+
+    // Runs the coroutine up to its next `co_yield` (or its end), rethrowing
+    // whatever it throws.
+    static void advance(handle coro) {
+        coro.resume();
+        if (coro.promise().error) {
+            std::rethrow_exception(std::exchange(coro.promise().error, {}));
+        }
+    }
+
+   public:
+    class iterator {
+        friend class generator;
+
+       private:
+        handle coro;
+
+        explicit iterator(handle coro) : coro(coro) {
+        }
+
+       public:
+        using value_type      = T;
+        using difference_type = ptrdiff_t;
+
+        iterator() = default;
+
+        auto operator*() const -> const T & {
+            return *coro.promise().current;
+        }
+
+        auto operator->() const -> const T * {
+            return coro.promise().current;
+        }
+
+        auto operator++() -> iterator & {
+            advance(coro);
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        friend auto operator==(const iterator &it, std::default_sentinel_t)
+            -> bool {
+            return !it.coro || it.coro.done();
+        }
+    };
+
+    generator() = default;
+
+    generator(generator &&other) noexcept
+        : coro(std::exchange(other.coro, {})) {
+    }
+
+    auto operator=(generator &&other) noexcept -> generator & {
+        if (this != &other) {
+            if (coro) coro.destroy();
+            coro = std::exchange(other.coro, {});
+        }
+        return *this;
+    }
+
+    generator(const generator &)                    = delete;
+    auto operator=(const generator &) -> generator & = delete;
+
+    ~generator() {
+        if (coro) coro.destroy();
+    }
+
+    // Starts the coroutine, running it up to its first element. Being
+    // single-pass, a generator may only be iterated once.
+    auto begin() -> iterator {
+        if (coro) advance(coro);
+        return iterator(coro);
+    }
+
+    auto end() -> std::default_sentinel_t {
+        return std::default_sentinel;
+    }
+};
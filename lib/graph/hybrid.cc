@@ -0,0 +1,4 @@
+#include "graph/hybrid.hh"
+
+template class HybridStarDigraph<ForwardStarDigraph>;
+template class HybridStarDigraph<ReverseStarDigraph>;
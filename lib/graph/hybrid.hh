@@ -0,0 +1,331 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph/bitset.hh"
+#include "graph/parallel.hh"
+#include "graph/search.hh"
+#include "graph/star.hh"
+
+// Iterates over a neighbor list that is either a slice of a star's `edges` or,
+// for hubs, a bitset with a bit set for each neighbor.
+class HybridNeighborsIterable {
+    template <typename G>
+    friend class HybridStarDigraph;
+
+   public:
+    class iterator {
+        friend class HybridNeighborsIterable;
+
+       private:
+        // list mode: the current neighbor
+        const uint32_t *list = nullptr;
+        // bitset mode: the current word index and its bits not yet visited
+        const uint64_t *words = nullptr;
+        size_t word_i         = 0;
+        size_t words_count    = 0;
+        uint64_t word         = 0;
+
+        void skip_empty_words() {
+            while (word == 0 && ++word_i < words_count) word = words[word_i];
+        }
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = uint32_t;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const uint32_t *;
+        using reference         = uint32_t;
+
+        iterator() = default;
+
+        auto operator*() const -> uint32_t {
+            if (words == nullptr) return *list;
+            return word_i * Bitset::WORD_BITS + std::countr_zero(word);
+        }
+
+        auto operator++() -> iterator & {
+            if (words == nullptr) {
+                list++;
+            } else {
+                word &= word - 1;
+                skip_empty_words();
+            }
+            return *this;
+        }
+
+        auto operator++(int) -> iterator {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        auto operator==(const iterator &other) const -> bool {
+            return list == other.list && word_i == other.word_i &&
+                   word == other.word;
+        }
+    };
+
+   private:
+    iterator _begin;
+    iterator _end;
+
+    HybridNeighborsIterable(const uint32_t *first, const uint32_t *last) {
+        _begin.list = first;
+        _end.list   = last;
+    }
+
+    HybridNeighborsIterable(const Bitset &bits) {
+        for (iterator *it : {&_begin, &_end}) {
+            it->words       = bits.data();
+            it->words_count = bits.words_count();
+        }
+        _end.word_i = bits.words_count();
+        if (bits.words_count() != 0) {
+            _begin.word = bits.data()[0];
+            _begin.skip_empty_words();
+        }
+    }
+
+   public:
+    auto begin() {
+        return _begin;
+    }
+
+    auto end() {
+        return _end;
+    }
+};
+
+// A copy of the star digraph `G` in which the neighbors of very high degree
+// vertexes (hubs) are stored as a bitset over all the vertexes instead of in
+// `edges`. Past `|V| / 32` neighbors, a bitset is no larger than the list, and
+// it turns `has_edge` into a single bit test and intersections (as used by
+// bottom-up BFS steps and similarity measures) into word-wide ANDs. The
+// iteration API is the same as `G`'s.
+//
+// Since a bitset can't hold an arc twice, parallel arcs out of a hub are
+// merged, and hub neighbors are always visited in ascending order.
+template <typename G>
+class HybridStarDigraph {
+   private:
+    static constexpr bool FORWARD = std::same_as<G, ForwardStarDigraph>;
+
+    std::vector<uint32_t> ptrs;
+    std::vector<uint32_t> edges;
+    bool sorted;
+    // 1 + the index of the vertex's bitset in `hubs`, or 0 if it's no hub.
+    std::vector<uint32_t> hub_of;
+    std::vector<Bitset> hubs;
+    std::vector<uint32_t> hub_degrees;
+
+    auto neighbors(uint32_t vertex) -> HybridNeighborsIterable {
+        if (hub_of.at(vertex) != 0U) return {hubs[hub_of[vertex] - 1]};
+        return {edges.data() + ptrs[vertex], edges.data() + ptrs[vertex + 1]};
+    }
+
+    auto degree(uint32_t vertex) -> uint32_t {
+        if (hub_of.at(vertex) != 0U) return hub_degrees[hub_of[vertex] - 1];
+        return ptrs[vertex + 1] - ptrs[vertex];
+    }
+
+    // Returns whether the neighbors of `vertex` contain `key`.
+    auto contains(uint32_t vertex, uint32_t key) -> bool {
+        if (hub_of.at(vertex) != 0U) {
+            const Bitset &bits = hubs[hub_of[vertex] - 1];
+            return key < bits.size() && bits.test(key);
+        }
+        return neighbors_contain(edges.data() + ptrs[vertex],
+                                 ptrs[vertex + 1] - ptrs[vertex], key, sorted);
+    }
+
+   public:
+    // Returns the smallest degree for which a bitset takes no more memory
+    // than a list of 32-bit neighbors, in a graph with `vertex_count`
+    // vertexes.
+    static auto default_hub_threshold(size_t vertex_count) -> size_t {
+        return std::max(vertex_count / 32, Bitset::WORD_BITS);
+    }
+
+    // Copies `g`, moving the neighbors of every vertex with at least
+    // `hub_threshold` of them into a bitset.
+    HybridStarDigraph(G &g, size_t hub_threshold) : sorted(g.is_sorted()) {
+        const auto g_ptrs  = g.neighbor_offsets();
+        const auto g_edges = g.neighbor_array();
+        const size_t n     = g_ptrs.size() - 2;
+        hub_of.assign(n + 2, 0);
+        for (size_t v = 1; v <= n; v++) {
+            if (g_ptrs[v + 1] - g_ptrs[v] >= hub_threshold) {
+                hubs.emplace_back(n + 1);
+                hub_of[v] = hubs.size();
+            }
+        }
+
+        // the same two passes as in `extract_star`, leaving hubs empty
+        ptrs.assign(n + 2, 0);
+        for (size_t v = 1; v <= n; v++) {
+            ptrs[v + 1] = hub_of[v] != 0U ? 0 : g_ptrs[v + 1] - g_ptrs[v];
+        }
+        ptrs[1] = 1;  // first element of `edges` is unused
+        for (size_t v = 1; v <= n; v++) ptrs[v + 1] += ptrs[v];
+        edges.resize(ptrs[n + 1]);
+        edges[0] = 0;
+        hub_degrees.resize(hubs.size());
+        parallel_for(n, [&](size_t begin, size_t end) {
+            for (size_t v = begin + 1; v <= end; v++) {
+                const auto first = g_edges.begin() + g_ptrs[v];
+                const auto last  = g_edges.begin() + g_ptrs[v + 1];
+                if (hub_of[v] == 0U) {
+                    std::copy(first, last, edges.begin() + ptrs[v]);
+                    continue;
+                }
+                Bitset &bits = hubs[hub_of[v] - 1];
+                for (auto it = first; it != last; it++) bits.set(*it);
+                hub_degrees[hub_of[v] - 1] = bits.count();
+            }
+        });
+    }
+
+    // Returns whether the given vertex has its neighbors in a bitset.
+    auto is_hub(uint32_t vertex) -> bool {
+        return hub_of.at(vertex) != 0U;
+    }
+
+    // Returns the number of hubs.
+    auto hubs_count() -> size_t {
+        return hubs.size();
+    }
+
+    // Returns the number of vertexes in the graph.
+    auto vertexes_count() {
+        return ptrs.size() - 2;
+    }
+
+    // Returns an iterable over all the vertexes.
+    auto vertexes() {
+        return std::views::iota(1U, ptrs.size() - 1);
+    }
+
+    // Returns an iterable over the sucessor vertexes for the given vertex.
+    auto successors(uint32_t vertex) -> HybridNeighborsIterable
+        requires FORWARD
+    {
+        return neighbors(vertex);
+    }
+
+    // Returns an iterable over the predecessor vertexes for the given vertex.
+    auto predecessors(uint32_t vertex) -> HybridNeighborsIterable
+        requires(!FORWARD)
+    {
+        return neighbors(vertex);
+    }
+
+    // Hints that the neighbors of the given vertex will be needed soon, so
+    // that where they start is fetched into the cache.
+    void prefetch(uint32_t vertex) {
+        __builtin_prefetch(hub_of.data() + vertex);
+        __builtin_prefetch(ptrs.data() + vertex);
+    }
+
+    // Returns the outdegree for the given vertex.
+    auto outdegree(uint32_t vertex) -> uint32_t
+        requires FORWARD
+    {
+        return degree(vertex);
+    }
+
+    // Returns the indegree for the given vertex.
+    auto indegree(uint32_t vertex) -> uint32_t
+        requires(!FORWARD)
+    {
+        return degree(vertex);
+    }
+
+    // Returns whether the arc `orig -> dest` exists; a bit test for hubs.
+    auto has_edge(uint32_t orig, uint32_t dest) -> bool {
+        return FORWARD ? contains(orig, dest) : contains(dest, orig);
+    }
+
+    // Returns the number of distinct vertexes that are neighbors of both `u`
+    // and `v`. Two hubs are intersected a word at a time, a hub and a list by
+    // testing the list against the bitset, and two lists by merging them.
+    auto common_neighbors_count(uint32_t u, uint32_t v) -> uint32_t {
+        if (!sorted) {
+            throw std::logic_error("intersection requires sorted neighbors");
+        }
+        if (is_hub(v)) std::swap(u, v);
+        if (is_hub(v)) {
+            const Bitset &a = hubs[hub_of[u] - 1];
+            const Bitset &b = hubs[hub_of[v] - 1];
+            uint32_t count  = 0;
+            for (size_t i = 0; i < a.words_count(); i++) {
+                count += std::popcount(a.data()[i] & b.data()[i]);
+            }
+            return count;
+        }
+
+        uint32_t count        = 0;
+        uint32_t last         = 0;  // skips parallel arcs, as 0 is not valid
+        const uint32_t *b     = edges.data() + ptrs[v];
+        const uint32_t *b_end = edges.data() + ptrs[v + 1];
+        if (is_hub(u)) {
+            const Bitset &a = hubs[hub_of[u] - 1];
+            for (; b != b_end; b++) {
+                if (*b != last && a.test(*b)) count++;
+                last = *b;
+            }
+            return count;
+        }
+
+        const uint32_t *a     = edges.data() + ptrs[u];
+        const uint32_t *a_end = edges.data() + ptrs[u + 1];
+        while (a != a_end && b != b_end) {
+            if (*a < *b) {
+                a = galloping_lower_bound(a, a_end, *b);
+            } else if (*b < *a) {
+                b = galloping_lower_bound(b, b_end, *a);
+            } else {
+                if (*a != last) count++;
+                last = *a++;
+                b++;
+            }
+        }
+        return count;
+    }
+
+    // Returns the first neighbor of `vertex` that is in `set`, or 0 if there
+    // is none. This is the step of a bottom-up BFS (with `set` holding the
+    // frontier), which for a hub is a word-wide AND against the frontier.
+    auto first_neighbor_in(uint32_t vertex, const Bitset &set) -> uint32_t {
+        if (is_hub(vertex)) {
+            const Bitset &bits = hubs[hub_of[vertex] - 1];
+            const size_t words =
+                std::min(bits.words_count(), set.words_count());
+            for (size_t i = 0; i < words; i++) {
+                const uint64_t both = bits.data()[i] & set.data()[i];
+                if (both != 0U) {
+                    return i * Bitset::WORD_BITS + std::countr_zero(both);
+                }
+            }
+            return 0;
+        }
+        for (uint32_t e = ptrs[vertex]; e < ptrs[vertex + 1]; e++) {
+            if (edges[e] < set.size() && set.test(edges[e])) return edges[e];
+        }
+        return 0;
+    }
+};
+
+// Both instantiations are compiled once, into the library itself.
+extern template class HybridStarDigraph<ForwardStarDigraph>;
+extern template class HybridStarDigraph<ReverseStarDigraph>;
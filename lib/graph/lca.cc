@@ -0,0 +1,75 @@
+#include "graph/lca.hh"
+
+#include <bit>
+#include <stdexcept>
+
+#include "graph/parallel.hh"
+
+lca_index::lca_index(dfs_result &res) {
+    if (res.discovery_rank.empty()) res.index_discovery_order();
+    const std::vector<NodeId> &order = res.discovery_order;
+    const size_t n                   = res.ctl.size();
+    const size_t m                   = order.size();
+
+    rank.assign(n + 1, 0);
+    depth.assign(n + 1, UNDISCOVERED);
+    parent.assign(n + 1, 0);
+    // parents are discovered before their children
+    for (size_t i = 0; i < m; i++) {
+        const NodeId v = order[i];
+        rank[v]        = i;
+        parent[v]      = res.at_v(v).parent;
+        depth[v]       = parent[v] == 0 ? 0 : depth[parent[v]] + 1;
+    }
+
+    table.push_back(order);
+    for (size_t half = 1; 2 * half <= m; half *= 2) {
+        const std::vector<NodeId> &prev = table.back();
+        std::vector<NodeId> level(m - 2 * half + 1);
+        parallel_for(level.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const NodeId a = prev[i];
+                const NodeId b = prev[i + half];
+                level[i]       = depth[b] < depth[a] ? b : a;
+            }
+        });
+        table.push_back(std::move(level));
+    }
+}
+
+// Throws unless `v` is a vertex of a graph with `n` vertexes.
+static void check_vertex(NodeId v, size_t n) {
+    if (v == 0 || v > n) throw std::out_of_range("invalid vertex");
+}
+
+auto lca_index::lca(NodeId u, NodeId v) const -> NodeId {
+    check_vertex(u, rank.size() - 1);
+    check_vertex(v, rank.size() - 1);
+    if (depth[u] == UNDISCOVERED || depth[v] == UNDISCOVERED) return 0;
+    if (u == v) return u;
+
+    size_t lo = rank[u];
+    size_t hi = rank[v];
+    if (lo > hi) std::swap(lo, hi);
+    // the shallowest vertex in positions `(lo, hi]`
+    const size_t level = std::bit_width(hi - lo) - 1;
+    const NodeId a     = table[level][lo + 1];
+    const NodeId b     = table[level][hi + 1 - (size_t{1} << level)];
+    return parent[depth[b] < depth[a] ? b : a];
+}
+
+auto lca_index::batch_lca(
+    const std::vector<std::pair<NodeId, NodeId>> &queries) const
+    -> std::vector<NodeId> {
+    for (const auto &[u, v] : queries) {
+        check_vertex(u, rank.size() - 1);
+        check_vertex(v, rank.size() - 1);
+    }
+    std::vector<NodeId> answers(queries.size());
+    parallel_for(queries.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            answers[i] = lca(queries[i].first, queries[i].second);
+        }
+    });
+    return answers;
+}
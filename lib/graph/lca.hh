@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "graph/dfs.hh"
+#include "graph/visitor.hh"
+
+// Answers lowest common ancestor queries over the forest of a DFS in O(1),
+// after O(V log V) preprocessing.
+//
+// This is the usual reduction to a range minimum query over an Euler tour,
+// over the discovery order instead, which holds each vertex once (so it takes
+// half the memory): if `u` is discovered before `v`, their lowest common
+// ancestor is the parent of the shallowest vertex discovered after `u` and up
+// to `v` (for `u` ancestral to `v`, that's the child of `u` on the way to `v`;
+// otherwise, it's the child of the ancestor that leads to `v`). Those minima
+// are found in a sparse table, whose level `k` holds the shallowest vertex of
+// each run of `2^k` consecutive ones, so any range is covered by two runs.
+// Takes `4 * V * (log V + 3)` bytes.
+class lca_index {
+   private:
+    static constexpr uint32_t UNDISCOVERED = UINT32_MAX;
+
+    // The position of each vertex in the discovery order.
+    std::vector<uint32_t> rank;
+    // The depth of each vertex in its tree, or `UNDISCOVERED`.
+    std::vector<uint32_t> depth;
+    std::vector<NodeId> parent;
+    // `table[k][i]` is the shallowest vertex among the `2^k` ones from
+    // position `i` of the discovery order (`table[0]` is the order itself).
+    std::vector<std::vector<NodeId>> table;
+
+   public:
+    // Builds the index from the parents and discovery times in `res` (which
+    // may be from a stopped search). Each level of the table is built in
+    // parallel.
+    lca_index(dfs_result &res);
+
+    // Returns the lowest common ancestor of `u` and `v`, or 0 if they are in
+    // different trees of the forest, or either one is undiscovered.
+    [[nodiscard]] auto lca(NodeId u, NodeId v) const -> NodeId;
+
+    // Answers a batch of queries, in parallel. Results are in the order of the
+    // queries. Throws, before answering any, if one has an invalid vertex.
+    [[nodiscard]] auto batch_lca(
+        const std::vector<std::pair<NodeId, NodeId>> &queries) const
+        -> std::vector<NodeId>;
+};
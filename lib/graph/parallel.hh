@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Below this many items, `parallel_for` runs the body on the calling thread,
+// since spawning threads would cost more than it saves.
+const size_t PARALLEL_GRAIN = 1U << 14U;
+
+// Splits `[0, n)` into contiguous chunks and calls `body(begin, end)` for each
+// of them, with at most one chunk per hardware thread. Returns only after all
+// chunks are done.
+template <typename F>
+void parallel_for(size_t n, F &&body) {
+    const size_t threads =
+        std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t chunks =
+        std::min(threads, (n + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN);
+    if (chunks <= 1) {
+        body(size_t{0}, n);
+        return;
+    }
+    const size_t step = (n + chunks - 1) / chunks;
+    std::vector<std::thread> pool;
+    pool.reserve(chunks - 1);
+    for (size_t begin = step; begin < n; begin += step) {
+        pool.emplace_back([&body, begin, end = std::min(begin + step, n)] {
+            body(begin, end);
+        });
+    }
+    body(size_t{0}, step);
+    for (auto &t : pool) t.join();
+}
@@ -0,0 +1,135 @@
+#include "graph/scc.hh"
+
+#include <algorithm>
+
+#include "graph/bitset.hh"
+#include "graph/parallel.hh"
+
+auto strongly_connected_components(ForwardStarDigraph &g) -> scc_result {
+    using iterator = decltype(g.successors(1).begin());
+    struct frame {
+        uint32_t vertex;
+        iterator next;
+        iterator end;
+    };
+
+    const size_t n = g.vertexes_count();
+    scc_result res;
+    res.component.assign(n + 1, 0);
+    // `index` is the preorder number of each vertex (0 while unvisited), and
+    // `low` the lowest one reachable from its subtree through at most one
+    // arc that leaves it, among the vertexes still on `open`.
+    std::vector<uint32_t> index(n + 1, 0);
+    std::vector<uint32_t> low(n + 1, 0);
+    Bitset on_open(n + 1);
+    std::vector<uint32_t> open;
+    std::vector<frame> st;
+    uint32_t counter = 0;
+
+    const auto push = [&](uint32_t v) {
+        index[v] = low[v] = ++counter;
+        open.push_back(v);
+        on_open.set(v);
+        auto succs = g.successors(v);
+        st.push_back({v, succs.begin(), succs.end()});
+    };
+
+    for (uint32_t root = 1; root <= n; root++) {
+        if (index[root] != 0) continue;
+        push(root);
+        while (!st.empty()) {
+            frame &f         = st.back();
+            const uint32_t v = f.vertex;
+            if (f.next != f.end) {
+                const uint32_t w = *f.next;
+                ++f.next;
+                if (index[w] == 0) {
+                    push(w);
+                } else if (on_open.test(w)) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+                continue;
+            }
+            st.pop_back();
+            if (!st.empty()) {
+                const uint32_t p = st.back().vertex;
+                low[p]           = std::min(low[p], low[v]);
+            }
+            if (low[v] != index[v]) continue;
+            // `v` is the root of a component, which is made of it and
+            // everything above it on `open`. Components are found sinks
+            // first, so they are numbered backwards here and flipped below.
+            res.count++;
+            uint32_t w = 0;
+            do {
+                w = open.back();
+                open.pop_back();
+                on_open.reset(w);
+                res.component[w] = res.count;
+            } while (w != v);
+        }
+    }
+    for (uint32_t v = 1; v <= n; v++) {
+        res.component[v] = res.count + 1 - res.component[v];
+    }
+    return res;
+}
+
+auto condensation(ForwardStarDigraph &g, const scc_result &scc)
+    -> ForwardStarDigraph {
+    const auto g_ptrs  = g.neighbor_offsets();
+    const auto g_edges = g.neighbor_array();
+    const size_t n     = g_ptrs.size() - 2;
+    const size_t c     = scc.count;
+
+    // the members of each component, counting sorted by component
+    std::vector<uint32_t> member_ptrs(c + 2, 0);
+    for (uint32_t v = 1; v <= n; v++) member_ptrs[scc.component[v] + 1]++;
+    for (size_t a = 1; a <= c; a++) member_ptrs[a + 1] += member_ptrs[a];
+    std::vector<uint32_t> members(n);
+    {
+        std::vector<uint32_t> cursor(member_ptrs.begin(), member_ptrs.end());
+        for (uint32_t v = 1; v <= n; v++) {
+            members[cursor[scc.component[v]]++] = v;
+        }
+    }
+
+    // Collects into `out` the sorted, distinct components reached by the
+    // arcs leaving component `a`.
+    const auto arcs_of = [&](size_t a, std::vector<uint32_t> &out) {
+        out.clear();
+        for (uint32_t i = member_ptrs[a]; i < member_ptrs[a + 1]; i++) {
+            const uint32_t v = members[i];
+            for (uint32_t e = g_ptrs[v]; e < g_ptrs[v + 1]; e++) {
+                const uint32_t b = scc.component[g_edges[e]];
+                if (b != a) out.push_back(b);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    };
+
+    // first pass: count (shifted by one, so that the scan is in-place)
+    std::vector<uint32_t> ptrs(c + 2, 0);
+    parallel_for(c, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> out;
+        for (size_t a = begin + 1; a <= end; a++) {
+            arcs_of(a, out);
+            ptrs[a + 1] = out.size();
+        }
+    });
+    ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t a = 1; a <= c; a++) ptrs[a + 1] += ptrs[a];
+
+    // second pass: write
+    std::vector<uint32_t> edges(ptrs[c + 1]);
+    edges[0] = 0;
+    parallel_for(c, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> out;
+        for (size_t a = begin + 1; a <= end; a++) {
+            arcs_of(a, out);
+            std::copy(out.begin(), out.end(), edges.begin() + ptrs[a]);
+        }
+    });
+    return {std::move(ptrs), std::move(edges), true};
+}
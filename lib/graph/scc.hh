@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "graph/star.hh"
+
+// The strongly connected components of a digraph. Components are numbered
+// from 1 in topological order of the condensation: every arc between two
+// components goes from a lower numbered one to a higher numbered one.
+struct scc_result {
+    // The component of each vertex, indexed by vertex (the first element is
+    // unused).
+    std::vector<uint32_t> component;
+    uint32_t count = 0;
+};
+
+// Finds the strongly connected components of `g` with Tarjan's algorithm,
+// iteratively (so deep graphs don't overflow the call stack), in O(V + E).
+auto strongly_connected_components(ForwardStarDigraph &g) -> scc_result;
+
+// Returns the condensation of `g`: a DAG with a vertex per component of
+// `scc` and an arc `a -> b` for each pair of distinct components with some
+// arc from `a` to `b` in `g`. Successor lists are sorted and have no
+// repeats. Built in two parallel passes over the vertexes.
+auto condensation(ForwardStarDigraph &g, const scc_result &scc)
+    -> ForwardStarDigraph;
@@ -0,0 +1,45 @@
+#include "graph/search.hh"
+
+#include <algorithm>
+
+#include "graph/parallel.hh"
+
+auto batch_neighbors_contain(
+    const std::vector<uint32_t> &ptrs, const std::vector<uint32_t> &edges,
+    bool sorted, const std::vector<std::pair<uint32_t, uint32_t>> &queries)
+    -> std::vector<bool> {
+    std::vector<uint32_t> order(queries.size());
+    for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return queries[a] < queries[b];
+    });
+
+    std::vector<bool> res(queries.size());
+    uint32_t list         = 0;
+    const uint32_t *first = nullptr;
+    const uint32_t *last  = nullptr;
+    for (const uint32_t i : order) {
+        const auto [v, key] = queries[i];
+        if (v != list || first == nullptr) {
+            list  = v;
+            first = edges.data() + ptrs.at(v);
+            last  = edges.data() + ptrs.at(v + 1);
+        }
+        if (!sorted) {
+            res[i] = std::find(first, last, key) != last;
+            continue;
+        }
+        first  = galloping_lower_bound(first, last, key);
+        res[i] = first != last && *first == key;
+    }
+    return res;
+}
+
+void sort_neighbor_lists(const std::vector<uint32_t> &ptrs,
+                         std::vector<uint32_t> &edges) {
+    parallel_for(ptrs.size() - 2, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            std::sort(edges.begin() + ptrs[v], edges.begin() + ptrs[v + 1]);
+        }
+    });
+}
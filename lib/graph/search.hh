@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Neighbor lists at least this long are considered a hub's. The only thing
+// that changes for them is that `branchless_lower_bound` (and so `has_edge`)
+// prefetches its next probes, since those are likely to miss the cache; the
+// search itself is still a plain binary search. Galloping, which only pays off
+// when consecutive keys are close, is left to `batch_neighbors_contain`.
+const size_t HUB_DEGREE = 1024;
+
+// Returns the first element of the sorted range `[first, first + n)` that is
+// not less than `key`, as `std::lower_bound` does. The loop has no
+// data-dependent branches (the comparison is compiled to a conditional move),
+// so it does not pay for branch mispredictions, which are the common case in
+// a binary search.
+inline auto branchless_lower_bound(const uint32_t *first, size_t n,
+                                   uint32_t key) -> const uint32_t * {
+    if (n == 0) return first;
+    const bool hub = n >= HUB_DEGREE;
+    while (n > 1) {
+        const size_t half = n / 2;
+        if (hub) {
+            __builtin_prefetch(first + half / 2);
+            __builtin_prefetch(first + half + half / 2);
+        }
+        first = (first[half] < key) ? first + half : first;
+        n -= half;
+    }
+    return first + (*first < key ? 1 : 0);
+}
+
+// Returns the first element of the sorted range `[first, last)` that is not
+// less than `key`. Takes O(log d) steps, where `d` is the distance from
+// `first` to the result, so walking a long list with increasing keys (moving
+// `first` along) is cheaper than repeated binary searches over all of it.
+inline auto galloping_lower_bound(const uint32_t *first, const uint32_t *last,
+                                  uint32_t key) -> const uint32_t * {
+    const auto n = static_cast<size_t>(last - first);
+    size_t bound = 1;
+    while (bound < n && first[bound] < key) bound *= 2;
+    const size_t lo = bound / 2;
+    return branchless_lower_bound(first + lo, std::min(bound, n) - lo, key);
+}
+
+// Returns whether the `n` neighbors starting at `first` contain `key`. Unless
+// `sorted`, this is a linear scan.
+inline auto neighbors_contain(const uint32_t *first, size_t n, uint32_t key,
+                              bool sorted) -> bool {
+    if (!sorted) return std::find(first, first + n, key) != first + n;
+    const uint32_t *it = branchless_lower_bound(first, n, key);
+    return it != first + n && *it == key;
+}
+
+// Answers a batch of "does the neighbor list of `q.first` contain
+// `q.second`?" queries over a star. The queries are answered in sorted order,
+// so that each neighbor list is visited once, front to back, galloping from
+// the previous answer. Results are in the original order.
+auto batch_neighbors_contain(
+    const std::vector<uint32_t> &ptrs, const std::vector<uint32_t> &edges,
+    bool sorted, const std::vector<std::pair<uint32_t, uint32_t>> &queries)
+    -> std::vector<bool>;
+
+// Sorts, in parallel, each of the neighbor lists of a star.
+void sort_neighbor_lists(const std::vector<uint32_t> &ptrs,
+                         std::vector<uint32_t> &edges);
+
+// Merges the sorted ranges `[a, a_end)` and `[b, b_end)`, dropping repeated
+// elements, and calls `out(i, elem)` for the `i`-th element of the result.
+// Returns the length of the result.
+template <typename Out>
+auto merge_unique(const uint32_t *a, const uint32_t *a_end, const uint32_t *b,
+                  const uint32_t *b_end, Out out) -> uint32_t {
+    uint32_t count = 0;
+    uint32_t last  = 0;  // vertex 0 is not valid, so it never is a neighbor
+    while (a != a_end || b != b_end) {
+        const uint32_t next = (b == b_end || (a != a_end && *a <= *b)) ? *a++
+                                                                        : *b++;
+        if (next != last) {
+            out(count++, next);
+            last = next;
+        }
+    }
+    return count;
+}
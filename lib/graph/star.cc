@@ -0,0 +1,379 @@
+#include "graph/star.hh"
+
+#include <mutex>
+
+auto induced_maps(uint32_t vertex_count, std::vector<uint32_t> vertex_set)
+    -> std::pair<std::vector<uint32_t>, std::vector<uint32_t>> {
+    std::sort(vertex_set.begin(), vertex_set.end());
+    vertex_set.erase(std::unique(vertex_set.begin(), vertex_set.end()),
+                     vertex_set.end());
+    if (!vertex_set.empty() &&
+        (vertex_set.front() == 0U || vertex_set.back() > vertex_count)) {
+        throw std::out_of_range("vertex set has an invalid vertex");
+    }
+
+    std::vector<uint32_t> to_orig;
+    to_orig.reserve(vertex_set.size() + 1);
+    to_orig.push_back(0);
+    // last element is a sentinel, so that `to_new` may be indexed by any arc
+    std::vector<uint32_t> to_new(vertex_count + 2, 0);
+    for (const uint32_t v : vertex_set) {
+        to_orig.push_back(v);
+        to_new[v] = to_orig.size() - 1;
+    }
+    return {std::move(to_orig), std::move(to_new)};
+}
+
+auto range_map(uint32_t vertex_count, uint32_t lo, uint32_t hi)
+    -> std::vector<uint32_t> {
+    if (lo == 0U || lo > hi || hi > vertex_count) {
+        throw std::out_of_range("invalid vertex range");
+    }
+    std::vector<uint32_t> to_orig(hi - lo + 2);
+    to_orig[0] = 0;
+    for (uint32_t v = lo; v <= hi; v++) to_orig[v - lo + 1] = v;
+    return to_orig;
+}
+
+void check_star_layout(const std::vector<uint32_t> &ptrs,
+                       const std::vector<uint32_t> &edges) {
+    if (ptrs.size() < 2 || edges.empty() || ptrs[1] != 1 ||
+        ptrs.back() != edges.size() ||
+        !std::is_sorted(ptrs.begin() + 1, ptrs.end())) {
+        throw std::invalid_argument("arrays are not laid out as a star");
+    }
+#ifdef SANITY_CHECK
+    const size_t n = ptrs.size() - 2;
+    for (size_t e = 1; e < edges.size(); e++) {
+        if (edges[e] == 0U || edges[e] > n) {
+            throw std::invalid_argument("star has an invalid vertex");
+        }
+    }
+#endif
+}
+
+auto count_indegrees(size_t vertex_count, std::span<const uint32_t> edges)
+    -> std::vector<uint32_t> {
+    const size_t m = edges.size() - 1;
+    std::vector<uint32_t> counts(vertex_count + 1, 0);
+
+    if (vertex_count <= PRIVATE_HISTOGRAM_VERTEXES) {
+        std::vector<std::vector<uint32_t>> partials;
+        std::mutex partials_mutex;
+        parallel_for(m, [&](size_t begin, size_t end) {
+            std::vector<uint32_t> partial(vertex_count + 1, 0);
+            for (size_t e = begin + 1; e <= end; e++) partial[edges[e]]++;
+            const std::lock_guard lock(partials_mutex);
+            partials.push_back(std::move(partial));
+        });
+        parallel_for(vertex_count, [&](size_t begin, size_t end) {
+            for (const auto &partial : partials) {
+                for (size_t v = begin + 1; v <= end; v++) {
+                    counts[v] += partial[v];
+                }
+            }
+        });
+        return counts;
+    }
+
+    std::vector<std::atomic<uint32_t>> shared(vertex_count + 1);
+    parallel_for(m, [&](size_t begin, size_t end) {
+        for (size_t e = begin + 1; e <= end; e++) {
+            shared[edges[e]].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    parallel_for(vertex_count, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            counts[v] = shared[v].load(std::memory_order_relaxed);
+        }
+    });
+    return counts;
+}
+
+ForwardStarDigraph::ForwardStarDigraph(uint32_t vertex_count,
+                                       EdgeBag &edge_bag) {
+    const size_t ptrs_size = vertex_count + 2;
+    // first element is unused; last element is used as sentinel
+    ptrs.reserve(ptrs_size);
+    ptrs.push_back(0);
+    // first element is unused
+    edges.reserve(edge_bag.edges.size() + 1);
+    edges.push_back(0);
+
+    edge_bag.sort_by_orig();  // <------------ each ptr is a orig
+    uint32_t last_orig = 0;
+    for (const Edge e : edge_bag) {
+        // insert the new orig ptr while also avoiding holes due to vertexes
+        // without any successors
+        while (last_orig < e.orig) {
+            last_orig++;
+            ptrs.push_back(edges.size());
+        }
+        SANITY_CHECK_VECTOR_GROWTH(edges, "ForwardStarDigraph::edges");
+        edges.push_back(e.dest);
+    }
+    while (ptrs.size() < ptrs_size) {
+        SANITY_CHECK_VECTOR_GROWTH(ptrs, "ForwardStarDigraph::ptrs");
+        ptrs.push_back(edges.size());
+    }
+}
+
+auto ForwardStarDigraph::max_outdegree() -> vertex_degree {
+    uint32_t max_outdeg = 0;
+    uint32_t max_v      = 0;
+    for (const uint32_t v : vertexes()) {
+        const uint32_t outdeg = outdegree(v);
+        if (outdeg > max_outdeg) {
+            max_v      = v;
+            max_outdeg = outdeg;
+        }
+    }
+    return {.vertex = max_v, .degree = max_outdeg};
+}
+
+auto ForwardStarDigraph::degree_arrays() -> vertex_degrees {
+    const size_t n = ptrs.size() - 2;
+    std::vector<uint32_t> out(n + 1, 0);
+    for (size_t v = 1; v <= n; v++) out[v] = ptrs[v + 1] - ptrs[v];
+    return {count_indegrees(n, edges), std::move(out)};
+}
+
+void ForwardStarDigraph::sort_neighbors() {
+    if (sorted) return;
+    sort_neighbor_lists(ptrs, edges);
+    sorted = true;
+}
+
+auto ForwardStarDigraph::has_edges(
+    const std::vector<std::pair<uint32_t, uint32_t>> &queries)
+    -> std::vector<bool> {
+    return batch_neighbors_contain(ptrs, edges, sorted, queries);
+}
+
+auto ForwardStarDigraph::induced_subgraph(std::vector<uint32_t> vertex_set)
+    -> subgraph<ForwardStarDigraph> {
+    auto [to_orig, to_new] =
+        induced_maps(ptrs.size() - 2, std::move(vertex_set));
+    std::vector<uint32_t> sub_ptrs;
+    std::vector<uint32_t> sub_edges;
+    extract_star(
+        ptrs, edges, to_orig, [&](uint32_t v) { return to_new[v]; },
+        sub_ptrs, sub_edges);
+    return {ForwardStarDigraph(std::move(sub_ptrs), std::move(sub_edges),
+                               sorted),
+            std::move(to_orig)};
+}
+
+auto ForwardStarDigraph::range_subgraph(uint32_t lo, uint32_t hi)
+    -> subgraph<ForwardStarDigraph> {
+    auto to_orig = range_map(ptrs.size() - 2, lo, hi);
+    std::vector<uint32_t> sub_ptrs;
+    std::vector<uint32_t> sub_edges;
+    extract_star(
+        ptrs, edges, to_orig,
+        [lo, hi](uint32_t v) {
+            return lo <= v && v <= hi ? v - lo + 1 : 0;
+        },
+        sub_ptrs, sub_edges);
+    return {ForwardStarDigraph(std::move(sub_ptrs), std::move(sub_edges),
+                               sorted),
+            std::move(to_orig)};
+}
+
+void ForwardStarDigraph::dbg(std::ostream &sink) {
+    sink << "orig_ptrs: ";
+    for (auto v : ptrs) sink << v << " ";
+    sink << "\n";
+    sink << " arc_dest: ";
+    for (auto v : edges) sink << v << " ";
+    sink << "\n";
+}
+
+void ForwardStarDigraph::dot(std::ostream &sink) {
+    sink << "digraph G {\n";
+    for (const uint32_t orig : vertexes()) {
+        for (const uint32_t dest : successors(orig)) {
+            sink << "    " << orig << " -> " << dest << "\n";
+        }
+        sink << "\n";
+    }
+    sink << "}\n";
+}
+
+ReverseStarDigraph::ReverseStarDigraph(uint32_t vertex_count,
+                                       EdgeBag &edge_bag) {
+    const size_t ptrs_size = vertex_count + 2;
+    // first element is unused; last element is used as sentinel
+    ptrs.reserve(ptrs_size);
+    ptrs.push_back(0);
+    // first element is unused
+    edges.reserve(edge_bag.edges.size() + 1);
+    edges.push_back(0);
+
+    edge_bag.sort_by_dest();  // <------------ each ptr is a dest
+    uint32_t last_dest = 0;
+    for (const Edge e : edge_bag) {
+        // insert the new dest ptr while also avoiding holes due to vertexes
+        // without any predecessors
+        while (last_dest < e.dest) {
+            last_dest++;
+            ptrs.push_back(edges.size());
+        }
+        SANITY_CHECK_VECTOR_GROWTH(edges, "ReverseStarDigraph::edges");
+        edges.push_back(e.orig);
+    }
+    while (ptrs.size() < ptrs_size) {
+        SANITY_CHECK_VECTOR_GROWTH(ptrs, "ReverseStarDigraph::ptrs");
+        ptrs.push_back(edges.size());
+    }
+}
+
+auto ReverseStarDigraph::max_indegree() -> vertex_degree {
+    uint32_t max_indeg = 0;
+    uint32_t max_v     = 0;
+    for (const uint32_t v : vertexes()) {
+        const uint32_t indeg = indegree(v);
+        if (indeg > max_indeg) {
+            max_v     = v;
+            max_indeg = indeg;
+        }
+    }
+    return {.vertex = max_v, .degree = max_indeg};
+}
+
+void ReverseStarDigraph::sort_neighbors() {
+    if (sorted) return;
+    sort_neighbor_lists(ptrs, edges);
+    sorted = true;
+}
+
+auto ReverseStarDigraph::has_edges(
+    const std::vector<std::pair<uint32_t, uint32_t>> &queries)
+    -> std::vector<bool> {
+    // The predecessor lists are looked up by dest, so each query is flipped.
+    std::vector<std::pair<uint32_t, uint32_t>> flipped;
+    flipped.reserve(queries.size());
+    for (const auto &[orig, dest] : queries) flipped.emplace_back(dest, orig);
+    return batch_neighbors_contain(ptrs, edges, sorted, flipped);
+}
+
+auto ReverseStarDigraph::induced_subgraph(std::vector<uint32_t> vertex_set)
+    -> subgraph<ReverseStarDigraph> {
+    auto [to_orig, to_new] =
+        induced_maps(ptrs.size() - 2, std::move(vertex_set));
+    std::vector<uint32_t> sub_ptrs;
+    std::vector<uint32_t> sub_edges;
+    extract_star(
+        ptrs, edges, to_orig, [&](uint32_t v) { return to_new[v]; },
+        sub_ptrs, sub_edges);
+    return {ReverseStarDigraph(std::move(sub_ptrs), std::move(sub_edges),
+                               sorted),
+            std::move(to_orig)};
+}
+
+auto ReverseStarDigraph::range_subgraph(uint32_t lo, uint32_t hi)
+    -> subgraph<ReverseStarDigraph> {
+    auto to_orig = range_map(ptrs.size() - 2, lo, hi);
+    std::vector<uint32_t> sub_ptrs;
+    std::vector<uint32_t> sub_edges;
+    extract_star(
+        ptrs, edges, to_orig,
+        [lo, hi](uint32_t v) {
+            return lo <= v && v <= hi ? v - lo + 1 : 0;
+        },
+        sub_ptrs, sub_edges);
+    return {ReverseStarDigraph(std::move(sub_ptrs), std::move(sub_edges),
+                               sorted),
+            std::move(to_orig)};
+}
+
+void ReverseStarDigraph::dbg(std::ostream &sink) {
+    sink << "dest_ptrs: ";
+    for (auto v : ptrs) sink << v << " ";
+    sink << "\n";
+    sink << " arc_orig: ";
+    for (auto v : edges) sink << v << " ";
+    sink << "\n";
+}
+
+void ReverseStarDigraph::dot(std::ostream &sink) {
+    sink << "digraph G {\n";
+    for (const uint32_t dest : vertexes()) {
+        for (const uint32_t orig : predecessors(dest)) {
+            sink << "    " << orig << " -> " << dest << "\n";
+        }
+        sink << "\n";
+    }
+    sink << "}\n";
+}
+
+auto symmetrize(ForwardStarDigraph &fwd, ReverseStarDigraph &rev)
+    -> ForwardStarDigraph {
+    const auto f_ptrs  = fwd.neighbor_offsets();
+    const auto f_edges = fwd.neighbor_array();
+    const auto r_ptrs  = rev.neighbor_offsets();
+    const auto r_edges = rev.neighbor_array();
+    if (f_ptrs.size() != r_ptrs.size()) {
+        throw std::invalid_argument("graphs differ in vertex count");
+    }
+    if (!fwd.is_sorted() || !rev.is_sorted()) {
+        throw std::logic_error("symmetrize requires sorted neighbor lists");
+    }
+    const size_t n      = f_ptrs.size() - 2;
+    const auto merge_of = [&](size_t v, auto out) {
+        return merge_unique(f_edges.data() + f_ptrs[v],
+                            f_edges.data() + f_ptrs[v + 1],
+                            r_edges.data() + r_ptrs[v],
+                            r_edges.data() + r_ptrs[v + 1], out);
+    };
+
+    std::vector<uint32_t> ptrs(n + 2, 0);
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            ptrs[v + 1] = merge_of(v, [](uint32_t, uint32_t) {});
+        }
+    });
+    ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t v = 1; v <= n; v++) ptrs[v + 1] += ptrs[v];
+
+    std::vector<uint32_t> edges(ptrs[n + 1]);
+    edges[0] = 0;
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t v = begin + 1; v <= end; v++) {
+            uint32_t *out = edges.data() + ptrs[v];
+            merge_of(v, [out](uint32_t i, uint32_t u) { out[i] = u; });
+        }
+    });
+    return {std::move(ptrs), std::move(edges), true};
+}
+
+auto transpose(ForwardStarDigraph &fwd) -> ReverseStarDigraph {
+    const auto f_ptrs  = fwd.neighbor_offsets();
+    const auto f_edges = fwd.neighbor_array();
+    const size_t n     = f_ptrs.size() - 2;
+
+    // first pass: count
+    const std::vector<uint32_t> indegrees = count_indegrees(n, f_edges);
+    std::vector<uint32_t> ptrs(n + 2, 0);
+    ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t v = 1; v <= n; v++) ptrs[v + 1] = ptrs[v] + indegrees[v];
+
+    // second pass: scatter, with `cursors[v]` as the next free slot of `v`
+    std::vector<std::atomic<uint32_t>> cursors(n + 1);
+    for (size_t v = 1; v <= n; v++) {
+        cursors[v].store(ptrs[v], std::memory_order_relaxed);
+    }
+    std::vector<uint32_t> edges(ptrs[n + 1]);
+    edges[0] = 0;
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t u = begin + 1; u <= end; u++) {
+            for (uint32_t e = f_ptrs[u]; e < f_ptrs[u + 1]; e++) {
+                const uint32_t slot =
+                    cursors[f_edges[e]].fetch_add(1, std::memory_order_relaxed);
+                edges[slot] = u;
+            }
+        }
+    });
+    sort_neighbor_lists(ptrs, edges);
+    return {std::move(ptrs), std::move(edges), true};
+}
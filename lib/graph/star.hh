@@ -0,0 +1,441 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef SANITY_CHECK
+#include <iostream>
+#endif
+
+#include "graph/parallel.hh"
+#include "graph/search.hh"
+
+// XX: I should probably just use an array (perhaps wrapped by an owned_ptr) to
+// avoid any kind of size checks. It won't be a small change since I'd have to
+// also ditch vector's iterators in favor of my own implementation.
+#ifdef SANITY_CHECK
+#define SANITY_CHECK_VECTOR_GROWTH(ident, description)                 \
+    if (ident.size() == ident.capacity()) {                            \
+        std::cerr << "sanity: will realloc (" << description << ")\n"; \
+    }
+#else
+#define SANITY_CHECK_VECTOR_GROWTH(ident, description)
+#endif
+
+class Edge {
+   public:
+    uint32_t orig;
+    uint32_t dest;
+
+    Edge(uint32_t orig, uint32_t dest) : orig(orig), dest(dest) {
+        if (orig == 0U || dest == 0U) {
+            throw std::invalid_argument("vertex 0 is not valid");
+        }
+    }
+
+    [[nodiscard]] auto lt_by_orig(const Edge &other) const -> bool {
+        return (orig != other.orig) ? orig < other.orig : dest < other.dest;
+    }
+
+    [[nodiscard]] auto lt_by_dest(const Edge &other) const -> bool {
+        return (dest != other.dest) ? dest < other.dest : orig < other.orig;
+    }
+};
+
+class EdgeBag {
+    friend class ForwardStarDigraph;
+    friend class ReverseStarDigraph;
+
+   private:
+    std::vector<Edge> edges;
+
+    void sort_by_orig() {
+        std::sort(edges.begin(), edges.end(), [](auto &left, auto &right) {
+            return left.lt_by_orig(right);
+        });
+    }
+
+    void sort_by_dest() {
+        std::sort(edges.begin(), edges.end(), [](auto &left, auto &right) {
+            return left.lt_by_dest(right);
+        });
+    }
+
+   public:
+    EdgeBag(uint32_t size) {
+        edges.reserve(size);
+    }
+
+    void add(Edge e) {
+        SANITY_CHECK_VECTOR_GROWTH(edges, "edges");
+        edges.push_back(e);
+    }
+
+    [[nodiscard]] auto size() const -> size_t {
+        return edges.size();
+    }
+
+    [[nodiscard]] auto begin() const {
+        return edges.begin();
+    }
+
+    [[nodiscard]] auto end() const {
+        return edges.end();
+    }
+};
+
+template <typename G>
+class NeighborsIterable {
+    friend class ForwardStarDigraph;
+    friend class ReverseStarDigraph;
+
+   private:
+    const G &g;
+    uint32_t _start;
+    uint32_t _end;
+
+    NeighborsIterable(G &g, uint32_t start, uint32_t end)
+        : g(g), _start(start), _end(end) {
+    }
+
+   public:
+    auto begin() {
+        return g.edges.begin() + _start;
+    }
+
+    auto end() {
+        return g.edges.begin() + _end;
+    }
+};
+
+struct vertex_degree {
+    uint32_t vertex;
+    uint32_t degree;
+};
+
+// The indegree and the outdegree of every vertex. As usual, the first element
+// of each array is unused.
+struct vertex_degrees {
+    std::vector<uint32_t> in;
+    std::vector<uint32_t> out;
+};
+
+// Below this many vertexes, `count_indegrees` gives each thread its own
+// counters (small enough to stay in cache) and sums them at the end; above it,
+// every thread shares the same atomic counters.
+const size_t PRIVATE_HISTOGRAM_VERTEXES = 1U << 16U;
+
+// Returns the number of arcs in `edges` (a star's arc array, without its unused
+// first element) that point to each vertex, in parallel over the arcs.
+auto count_indegrees(size_t vertex_count, std::span<const uint32_t> edges)
+    -> std::vector<uint32_t>;
+
+// A subgraph carved out of a star digraph `G`. Its vertexes are relabeled to
+// the sequence `1..n` (as every star representation requires); `to_orig[v]`
+// holds the id that the new vertex `v` had in the original graph. As usual,
+// the first element is unused.
+template <typename G>
+struct subgraph {
+    G g;
+    std::vector<uint32_t> to_orig;
+};
+
+// Copies, from the star given by `ptrs` and `edges`, the arcs whose both ends
+// are kept, relabeling them on the way. `to_orig` maps each new vertex to its
+// original id and `to_new` maps an original id to its new one (or to 0 if the
+// vertex was dropped).
+//
+// Works in two parallel passes over the new vertexes: the first one counts the
+// surviving arcs of each vertex (which are then turned into `out_ptrs` by a
+// prefix sum) and the second one copies them into their final place. Since the
+// relabeling must be monotonic, sorted neighbor lists remain sorted.
+template <typename ToNew>
+void extract_star(const std::vector<uint32_t> &ptrs,
+                  const std::vector<uint32_t> &edges,
+                  const std::vector<uint32_t> &to_orig, ToNew to_new,
+                  std::vector<uint32_t> &out_ptrs,
+                  std::vector<uint32_t> &out_edges) {
+    const size_t n = to_orig.size() - 1;
+    out_ptrs.assign(n + 2, 0);
+
+    // first pass: count (shifted by one, so that the scan below is in-place)
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const uint32_t orig = to_orig[i + 1];
+            uint32_t count      = 0;
+            for (uint32_t e = ptrs[orig]; e < ptrs[orig + 1]; e++) {
+                count += to_new(edges[e]) != 0U ? 1U : 0U;
+            }
+            out_ptrs[i + 2] = count;
+        }
+    });
+    out_ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t v = 1; v <= n; v++) out_ptrs[v + 1] += out_ptrs[v];
+
+    // second pass: copy
+    out_edges.resize(out_ptrs[n + 1]);
+    out_edges[0] = 0;
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const uint32_t orig = to_orig[i + 1];
+            uint32_t pos        = out_ptrs[i + 1];
+            for (uint32_t e = ptrs[orig]; e < ptrs[orig + 1]; e++) {
+                const uint32_t dest = to_new(edges[e]);
+                if (dest != 0U) out_edges[pos++] = dest;
+            }
+        }
+    });
+}
+
+// Sorts and deduplicates `vertex_set`, ensuring that all of its ids are valid
+// in a graph with `vertex_count` vertexes. Returns the `to_orig` and `to_new`
+// maps used by `extract_star`.
+auto induced_maps(uint32_t vertex_count, std::vector<uint32_t> vertex_set)
+    -> std::pair<std::vector<uint32_t>, std::vector<uint32_t>>;
+
+// Returns the `to_orig` map for the vertexes in the closed range `[lo, hi]`.
+auto range_map(uint32_t vertex_count, uint32_t lo, uint32_t hi)
+    -> std::vector<uint32_t>;
+
+// Throws unless `ptrs` and `edges` have the layout of a star (as described in
+// `ForwardStarDigraph`'s constructor from them). Checks every pointer, so it
+// takes O(V); dests are only checked in sanity check mode.
+void check_star_layout(const std::vector<uint32_t> &ptrs,
+                       const std::vector<uint32_t> &edges);
+
+class ReverseStarDigraph;
+
+class ForwardStarDigraph {
+    friend class NeighborsIterable<ForwardStarDigraph>;
+
+   private:
+    std::vector<uint32_t> ptrs;
+    std::vector<uint32_t> edges;
+    // Whether each neighbor list is sorted. The constructor from an `EdgeBag`
+    // sorts the arcs anyway, so it always is; other builders must say so.
+    bool sorted = true;
+
+   public:
+    ForwardStarDigraph(uint32_t vertex_count, EdgeBag &edge_bag);
+
+    // Takes over the arrays of a star built elsewhere (by the algorithms in
+    // this library that make new graphs): the successors of `v` are
+    // `edges[ptrs[v]..ptrs[v + 1]]`, the first element of both arrays is
+    // unused and `ptrs` ends with a sentinel. `sorted` tells whether every
+    // list is sorted. Throws `std::invalid_argument` if the layout is wrong.
+    ForwardStarDigraph(std::vector<uint32_t> ptrs, std::vector<uint32_t> edges,
+                       bool sorted)
+        : ptrs(std::move(ptrs)), edges(std::move(edges)), sorted(sorted) {
+        check_star_layout(this->ptrs, this->edges);
+    }
+
+    // The star's arrays, read-only, for algorithms that walk the arcs by
+    // position (to index per-arc data, for instance), with the same layout
+    // as the constructor above takes.
+    auto neighbor_offsets() const -> std::span<const uint32_t> {
+        return ptrs;
+    }
+
+    auto neighbor_array() const -> std::span<const uint32_t> {
+        return edges;
+    }
+
+    // Returns the number of vertexes in the graph.
+    auto vertexes_count() {
+        // There are two extra elements (0, the first element and a sentinel at
+        // the end).
+        return ptrs.size() - 2;
+    }
+
+    // Returns an iterable over all the vertexes.
+    auto vertexes() {
+        return std::views::iota(1U, ptrs.size() - 1);
+    }
+
+    // Returns an iterable over the sucessor vertexes for the given vertex.
+    auto successors(uint32_t vertex) -> NeighborsIterable<ForwardStarDigraph> {
+        return NeighborsIterable(*this, ptrs.at(vertex), ptrs.at(vertex + 1));
+    }
+
+    // Hints that the neighbors of the given vertex will be needed soon, so
+    // that where they start is fetched into the cache.
+    void prefetch(uint32_t vertex) {
+        __builtin_prefetch(ptrs.data() + vertex);
+    }
+
+    // Returns the outdegree for the given vertex.
+    auto outdegree(uint32_t vertex) -> uint32_t {
+        auto it = successors(vertex);
+        return std::distance(it.begin(), it.end());
+    }
+
+    auto max_outdegree() -> vertex_degree;
+
+    // Returns the indegree and the outdegree of every vertex. Indegrees are
+    // counted straight from the arcs, so it's much cheaper than building the
+    // `ReverseStarDigraph` just for them.
+    auto degree_arrays() -> vertex_degrees;
+
+    // Returns whether every successor list is sorted.
+    auto is_sorted() -> bool {
+        return sorted;
+    }
+
+    // Sorts every successor list, restoring the sorted invariant.
+    void sort_neighbors();
+
+    // Returns whether the arc `orig -> dest` exists. It's a branchless binary
+    // search over the successors of `orig` (or a linear scan if they aren't
+    // sorted).
+    auto has_edge(uint32_t orig, uint32_t dest) -> bool {
+        const uint32_t start = ptrs.at(orig);
+        return neighbors_contain(edges.data() + start,
+                                 ptrs.at(orig + 1) - start, dest, sorted);
+    }
+
+    // Returns, for each `(orig, dest)` query, whether that arc exists. Cheaper
+    // than calling `has_edge` for each query when there are many of them.
+    auto has_edges(const std::vector<std::pair<uint32_t, uint32_t>> &queries)
+        -> std::vector<bool>;
+
+    // Returns the subgraph induced by the given vertexes, that is, with all of
+    // them and all the arcs between them. New ids follow the order of the
+    // original ones.
+    auto induced_subgraph(std::vector<uint32_t> vertex_set)
+        -> subgraph<ForwardStarDigraph>;
+
+    // Returns the subgraph induced by the vertexes in the closed range
+    // `[lo, hi]`, which are relabeled to `1..(hi - lo + 1)`.
+    auto range_subgraph(uint32_t lo, uint32_t hi)
+        -> subgraph<ForwardStarDigraph>;
+
+    void dbg(std::ostream &sink);
+
+    void dot(std::ostream &sink);
+};
+
+class ReverseStarDigraph {
+    friend class NeighborsIterable<ReverseStarDigraph>;
+
+   private:
+    std::vector<uint32_t> ptrs;
+    std::vector<uint32_t> edges;
+    // Whether each neighbor list is sorted. The constructor from an `EdgeBag`
+    // sorts the arcs anyway, so it always is; other builders must say so.
+    bool sorted = true;
+
+   public:
+    ReverseStarDigraph(uint32_t vertex_count, EdgeBag &edge_bag);
+
+    // Like `ForwardStarDigraph`'s, with the predecessors of `v` at
+    // `edges[ptrs[v]..ptrs[v + 1]]`.
+    ReverseStarDigraph(std::vector<uint32_t> ptrs, std::vector<uint32_t> edges,
+                       bool sorted)
+        : ptrs(std::move(ptrs)), edges(std::move(edges)), sorted(sorted) {
+        check_star_layout(this->ptrs, this->edges);
+    }
+
+    // Like `ForwardStarDigraph`'s.
+    auto neighbor_offsets() const -> std::span<const uint32_t> {
+        return ptrs;
+    }
+
+    auto neighbor_array() const -> std::span<const uint32_t> {
+        return edges;
+    }
+
+    // Returns an iterable over all the vertexes.
+    auto vertexes() {
+        return std::views::iota(1U, ptrs.size() - 1);
+    }
+
+    // Returns the number of vertexes in the graph.
+    auto vertexes_count() {
+        return ptrs.size() - 2;
+    }
+
+    // Returns an iterable over the predecessor vertexes for the given vertex.
+    auto predecessors(uint32_t vertex)
+        -> NeighborsIterable<ReverseStarDigraph> {
+        return NeighborsIterable(*this, ptrs.at(vertex), ptrs.at(vertex + 1));
+    }
+
+    // Hints that the neighbors of the given vertex will be needed soon, so
+    // that where they start is fetched into the cache.
+    void prefetch(uint32_t vertex) {
+        __builtin_prefetch(ptrs.data() + vertex);
+    }
+
+    // Returns the indegree for the given vertex.
+    auto indegree(uint32_t vertex) -> uint32_t {
+        auto it = predecessors(vertex);
+        return std::distance(it.begin(), it.end());
+    }
+
+    auto max_indegree() -> vertex_degree;
+
+    // Returns whether every predecessor list is sorted.
+    auto is_sorted() -> bool {
+        return sorted;
+    }
+
+    // Sorts every predecessor list, restoring the sorted invariant.
+    void sort_neighbors();
+
+    // Returns whether the arc `orig -> dest` exists. It's a branchless binary
+    // search over the predecessors of `dest` (or a linear scan if they aren't
+    // sorted).
+    auto has_edge(uint32_t orig, uint32_t dest) -> bool {
+        const uint32_t start = ptrs.at(dest);
+        return neighbors_contain(edges.data() + start,
+                                 ptrs.at(dest + 1) - start, orig, sorted);
+    }
+
+    // Returns, for each `(orig, dest)` query, whether that arc exists. Cheaper
+    // than calling `has_edge` for each query when there are many of them.
+    auto has_edges(const std::vector<std::pair<uint32_t, uint32_t>> &queries)
+        -> std::vector<bool>;
+
+    // Returns the subgraph induced by the given vertexes, that is, with all of
+    // them and all the arcs between them. New ids follow the order of the
+    // original ones.
+    auto induced_subgraph(std::vector<uint32_t> vertex_set)
+        -> subgraph<ReverseStarDigraph>;
+
+    // Returns the subgraph induced by the vertexes in the closed range
+    // `[lo, hi]`, which are relabeled to `1..(hi - lo + 1)`.
+    auto range_subgraph(uint32_t lo, uint32_t hi)
+        -> subgraph<ReverseStarDigraph>;
+
+    void dbg(std::ostream &sink);
+
+    void dot(std::ostream &sink);
+};
+
+// Builds the undirected view of the digraph represented by both `fwd` and
+// `rev` (which must have been built from the same arcs). Each undirected edge
+// `{u, v}` is stored as the two arcs `u -> v` and `v -> u`, so the result can
+// be used anywhere a `ForwardStarDigraph` is. The neighbors of a vertex are
+// the sorted and deduplicated merge of its successors and its predecessors.
+//
+// Like `extract_star`, it works in two parallel passes over the vertexes:
+// one to count the size of each merge and one to write it.
+auto symmetrize(ForwardStarDigraph &fwd, ReverseStarDigraph &rev)
+    -> ForwardStarDigraph;
+
+// Builds the `ReverseStarDigraph` of the arcs in `fwd`, without going back to
+// an `EdgeBag`. Works in two parallel passes: the first one counts the
+// indegrees (with `count_indegrees`) and the second one scatters each arc into
+// the predecessor list of its dest. The scatter shares a cursor per vertex, so
+// the threads write the lists in no particular order and they are sorted at
+// the end (each one is made of a few sorted runs, one per thread).
+auto transpose(ForwardStarDigraph &fwd) -> ReverseStarDigraph;
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+// A forward star digraph with `V` vertexes and `E` arcs, whose arrays are
+// fixed-size and may be computed at compile time (see
+// `make_static_forward_star`). Small graphs that are known up front thus need
+// no heap at all, and traversals over them may be fully evaluated by the
+// compiler. It is a structural type, so a constant of it may also be passed as
+// a template argument.
+//
+// The engines in `dfs.hh` and `bfs.hh` aren't specialized for it: they run on
+// it as on any other graph, heap and all. The heap-free traversals are
+// `static_dfs` and `static_bfs`, below.
+template <size_t V, size_t E>
+struct StaticForwardStarDigraph {
+    static constexpr size_t VERTEXES = V;
+    static constexpr size_t EDGES    = E;
+
+    // Same layout as in `ForwardStarDigraph`.
+    std::array<uint32_t, V + 2> ptrs{};
+    std::array<uint32_t, E + 1> edges{};
+
+    // Returns the number of vertexes in the graph.
+    [[nodiscard]] constexpr auto vertexes_count() const -> size_t {
+        return V;
+    }
+
+    // Returns an iterable over all the vertexes.
+    [[nodiscard]] constexpr auto vertexes() const {
+        return std::views::iota(1U, static_cast<uint32_t>(V + 1));
+    }
+
+    // Returns an iterable over the sucessor vertexes for the given vertex.
+    [[nodiscard]] constexpr auto successors(uint32_t vertex) const
+        -> std::span<const uint32_t> {
+        return {edges.data() + ptrs[vertex], ptrs[vertex + 1] - ptrs[vertex]};
+    }
+
+    // Returns the outdegree for the given vertex.
+    [[nodiscard]] constexpr auto outdegree(uint32_t vertex) const -> uint32_t {
+        return ptrs[vertex + 1] - ptrs[vertex];
+    }
+};
+
+// Builds the forward star of a graph with `V` vertexes from its arcs, as
+// `(orig, dest)` pairs. Meant to be evaluated at compile time, where an
+// invalid vertex is a compile error:
+//
+//     constexpr auto g = make_static_forward_star<5>(std::array{
+//         std::pair{3U, 4U}, std::pair{4U, 5U}, std::pair{1U, 3U}});
+template <size_t V, size_t E>
+constexpr auto make_static_forward_star(
+    std::array<std::pair<uint32_t, uint32_t>, E> arcs)
+    -> StaticForwardStarDigraph<V, E> {
+    for (const auto &[orig, dest] : arcs) {
+        if (orig == 0U || dest == 0U || orig > V || dest > V) {
+            throw std::invalid_argument("invalid vertex");
+        }
+    }
+    std::sort(arcs.begin(), arcs.end());
+
+    StaticForwardStarDigraph<V, E> g;
+    g.ptrs[1] = 1;  // first element of `edges` is unused
+    for (size_t i = 0; i < E; i++) {
+        g.edges[i + 1] = arcs[i].second;
+        g.ptrs[arcs[i].first + 1]++;
+    }
+    for (size_t v = 1; v <= V; v++) g.ptrs[v + 1] += g.ptrs[v];
+    return g;
+}
+
+// The outcome of a traversal over a `StaticForwardStarDigraph` with `V`
+// vertexes: the `count` reached vertexes in discovery `order`, and the
+// `parent` of each vertex (0 for roots and unreached vertexes).
+template <size_t V>
+struct static_traversal {
+    std::array<uint32_t, V> order{};
+    std::array<uint32_t, V + 1> parent{};
+    size_t count = 0;
+};
+
+// A DFS over all of `g`'s vertexes (in the same order as `dfs::execute`),
+// with its stack in a fixed-size array instead of on the heap.
+template <size_t V, size_t E>
+constexpr auto static_dfs(const StaticForwardStarDigraph<V, E> &g)
+    -> static_traversal<V> {
+    static_traversal<V> res;
+    std::array<bool, V + 1> discovered{};
+    // each frame is a vertex and the position of its next successor to visit
+    std::array<std::pair<uint32_t, uint32_t>, V> st{};
+    size_t top = 0;
+
+    for (uint32_t root = 1; root <= V; root++) {
+        if (discovered[root]) continue;
+        discovered[root]       = true;
+        res.order[res.count++] = root;
+        st[top++]              = {root, g.ptrs[root]};
+        while (top > 0) {
+            auto &[v, cursor] = st[top - 1];
+            if (cursor == g.ptrs[v + 1]) {
+                top--;
+                continue;
+            }
+            const uint32_t succ_v = g.edges[cursor++];
+            if (discovered[succ_v]) continue;
+            discovered[succ_v]     = true;
+            res.parent[succ_v]     = v;
+            res.order[res.count++] = succ_v;
+            st[top++]              = {succ_v, g.ptrs[succ_v]};
+        }
+    }
+    return res;
+}
+
+// A BFS from `source` over `g`, with its queue in a fixed-size array instead
+// of on the heap.
+template <size_t V, size_t E>
+constexpr auto static_bfs(const StaticForwardStarDigraph<V, E> &g,
+                          uint32_t source) -> static_traversal<V> {
+    if (source == 0U || source > V) {
+        throw std::out_of_range("invalid source vertex");
+    }
+    static_traversal<V> res;
+    std::array<bool, V + 1> discovered{};
+    // `order` is the queue itself, since vertexes leave it in discovery order
+    discovered[source]     = true;
+    res.order[res.count++] = source;
+    for (size_t head = 0; head < res.count; head++) {
+        const uint32_t v = res.order[head];
+        for (const uint32_t succ_v : g.successors(v)) {
+            if (discovered[succ_v]) continue;
+            discovered[succ_v]     = true;
+            res.parent[succ_v]     = v;
+            res.order[res.count++] = succ_v;
+        }
+    }
+    return res;
+}
+
+// Calls `visit(v)` for each vertex and `visit(parent, v)` for each tree edge of
+// the (constant) traversal `T`, in discovery order. Since `T` is known at
+// compile time, this expands into a straight-line sequence of calls, with no
+// loop or graph access left at run time:
+//
+//     constexpr auto t = static_dfs(g);
+//     unroll_traversal<t>(visitor);
+template <auto T, typename F>
+constexpr void unroll_traversal(F &&visit) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (
+            [&] {
+                constexpr uint32_t v      = T.order[I];
+                constexpr uint32_t parent = T.parent[v];
+                if constexpr (parent != 0U) visit(parent, v);
+                visit(v);
+            }(),
+            ...);
+    }(std::make_index_sequence<T.count>{});
+}
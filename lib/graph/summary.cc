@@ -0,0 +1,87 @@
+#include "graph/summary.hh"
+
+#include <algorithm>
+#include <mutex>
+
+#include "graph/parallel.hh"
+
+auto summarize_degrees(std::vector<uint32_t> &degrees) -> degree_summary {
+    const size_t n = degrees.size() - 1;
+    degree_summary res;
+    if (n == 0) return res;
+
+    res.min    = UINT32_MAX;
+    size_t sum = 0;
+    std::mutex res_mutex;
+    parallel_for(n, [&](size_t begin, size_t end) {
+        uint32_t min     = UINT32_MAX;
+        uint32_t max     = 0;
+        size_t chunk_sum = 0;
+        std::array<size_t, DEGREE_BUCKETS> histogram{};
+        for (size_t v = begin + 1; v <= end; v++) {
+            const uint32_t d = degrees[v];
+            min              = std::min(min, d);
+            max              = std::max(max, d);
+            chunk_sum += d;
+            histogram[degree_bucket(d)]++;
+        }
+        const std::lock_guard lock(res_mutex);
+        res.min = std::min(res.min, min);
+        res.max = std::max(res.max, max);
+        sum += chunk_sum;
+        for (size_t b = 0; b < DEGREE_BUCKETS; b++) {
+            res.histogram[b] += histogram[b];
+        }
+    });
+    res.mean  = static_cast<double>(sum) / static_cast<double>(n);
+    res.zeros = res.histogram[0];
+
+    const auto mid = degrees.begin() + 1 + (n - 1) / 2;
+    std::nth_element(degrees.begin() + 1, mid, degrees.end());
+    res.median = *mid;
+    return res;
+}
+
+auto summarize(ForwardStarDigraph &g) -> graph_summary {
+    g.sort_neighbors();
+    const size_t n = g.vertexes_count();
+
+    graph_summary res;
+    res.vertexes = n;
+    std::mutex res_mutex;
+    parallel_for(n, [&](size_t begin, size_t end) {
+        size_t arcs       = 0;
+        size_t loops      = 0;
+        size_t duplicates = 0;
+        size_t distinct   = 0;
+        size_t reciprocal = 0;
+        for (uint32_t u = begin + 1; u <= end; u++) {
+            uint32_t prev = 0;  // no vertex is 0
+            for (const uint32_t v : g.successors(u)) {
+                arcs++;
+                if (v == prev) {
+                    duplicates++;
+                    continue;
+                }
+                prev = v;
+                if (v == u) {
+                    loops++;
+                    continue;
+                }
+                distinct++;
+                if (g.has_edge(v, u)) reciprocal++;
+            }
+        }
+        const std::lock_guard lock(res_mutex);
+        res.arcs += arcs;
+        res.self_loops += loops;
+        res.duplicate_arcs += duplicates;
+        res.distinct_arcs += distinct;
+        res.reciprocal_arcs += reciprocal;
+    });
+
+    vertex_degrees degrees = g.degree_arrays();
+    res.out                = summarize_degrees(degrees.out);
+    res.in                 = summarize_degrees(degrees.in);
+    return res;
+}
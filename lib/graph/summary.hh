@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <bit>
+#include <vector>
+
+#include "graph/star.hh"
+
+// Degrees are bucketed by their bit width: bucket 0 holds degree 0, and bucket
+// `k > 0` holds the degrees in `[2^(k - 1), 2^k)`.
+const size_t DEGREE_BUCKETS = 33;
+
+struct degree_summary {
+    uint32_t min = 0;
+    uint32_t max = 0;
+    double mean  = 0.0;
+    // The lower median, when there is an even number of vertexes.
+    uint32_t median = 0;
+    // The number of vertexes with degree 0.
+    size_t zeros = 0;
+    std::array<size_t, DEGREE_BUCKETS> histogram{};
+};
+
+struct graph_summary {
+    size_t vertexes = 0;
+    size_t arcs     = 0;
+    degree_summary out;
+    degree_summary in;
+    // Arcs `v -> v`.
+    size_t self_loops = 0;
+    // Arcs that repeat an earlier `orig -> dest` (`k` equal arcs add `k - 1`).
+    size_t duplicate_arcs = 0;
+    // Distinct arcs `u -> v`, with `u != v`, and how many of them also have
+    // `v -> u`. Their ratio is the graph's reciprocity.
+    size_t distinct_arcs   = 0;
+    size_t reciprocal_arcs = 0;
+
+    [[nodiscard]] auto reciprocity() const -> double {
+        return distinct_arcs == 0 ? 0.0
+                                  : static_cast<double>(reciprocal_arcs) /
+                                        static_cast<double>(distinct_arcs);
+    }
+};
+
+// Returns the bucket of `degree` in `degree_summary::histogram`.
+constexpr auto degree_bucket(uint32_t degree) -> size_t {
+    return std::bit_width(degree);
+}
+
+// Summarizes the given degrees (whose first element is unused), in parallel
+// over the vertexes. Clobbers `degrees`, which is partially sorted to find the
+// median.
+auto summarize_degrees(std::vector<uint32_t> &degrees) -> degree_summary;
+
+// Computes, in one parallel pass over the vertexes (and one over the degree
+// arrays), the statistics that are worth knowing before working with a new
+// graph. Sorts the successor lists first if they aren't already, since
+// duplicates and reciprocal arcs are found by searching them.
+auto summarize(ForwardStarDigraph &g) -> graph_summary;
@@ -0,0 +1,73 @@
+#include "graph/temporal.hh"
+
+#include <algorithm>
+
+TemporalStarDigraph::TemporalStarDigraph(uint32_t vertex_count,
+                                         std::vector<TemporalEdge> arcs) {
+    std::sort(arcs.begin(), arcs.end(), [](auto &left, auto &right) {
+        return left.lt_by_orig_time(right);
+    });
+
+    // first element is unused; last element is used as sentinel
+    ptrs.assign(vertex_count + 2, 0);
+    // first element is unused
+    edges.reserve(arcs.size() + 1);
+    edges.push_back(0);
+    times.reserve(arcs.size() + 1);
+    times.push_back(0);
+    for (const TemporalEdge &e : arcs) {
+        if (e.orig > vertex_count || e.dest > vertex_count) {
+            throw std::out_of_range("arc has an invalid vertex");
+        }
+        ptrs[e.orig + 1]++;
+        edges.push_back(e.dest);
+        times.push_back(e.time);
+    }
+    ptrs[1] = 1;
+    for (size_t v = 1; v <= vertex_count; v++) ptrs[v + 1] += ptrs[v];
+}
+
+auto temporal_bfs::execute(TemporalStarDigraph &g, NodeId source, Timestamp t0,
+                           Timestamp t1) -> temporal_bfs_result {
+    const size_t n = g.vertexes_count();
+    if (source == 0 || source > n) {
+        throw std::out_of_range("invalid source vertex");
+    }
+    if (t0 > t1) throw std::invalid_argument("invalid time window");
+    temporal_bfs_result res(n);
+
+    // `scanned[v]` is where the arcs of `v` that were already visited start,
+    // or 0 if `v` was never dequeued (`edges[0]` is unused).
+    std::vector<uint32_t> scanned(n + 1, 0);
+    std::vector<bool> queued(n + 1, false);
+    std::vector<NodeId> queue;
+    size_t head = 0;
+
+    res.at_v(source).arrival = t0;
+    queue.push_back(source);
+    queued[source] = true;
+    while (head < queue.size()) {
+        const NodeId v = queue[head++];
+        queued[v]      = false;
+
+        const Timestamp arrival = res.at_v(v).arrival;
+        const auto [lo, hi]     = g.window(v, arrival, t1);
+        const uint32_t end      = scanned[v] == 0U ? hi : scanned[v];
+        scanned[v]              = lo;
+        for (uint32_t e = lo; e < end; e++) {
+            const NodeId succ_v            = g.edges[e];
+            const Timestamp time           = g.times[e];
+            temporal_bfs_entry &succ_entry = res.at_v(succ_v);
+            if (time >= succ_entry.arrival) continue;
+            edge_visitor(v, succ_v);
+            succ_entry.arrival = time;
+            succ_entry.parent  = v;
+            if (!queued[succ_v]) {
+                queue.push_back(succ_v);
+                queued[succ_v] = true;
+            }
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph/search.hh"
+#include "graph/visitor.hh"
+
+// Seconds (or any other unit) since some epoch.
+using Timestamp = uint32_t;
+
+class TemporalEdge {
+   public:
+    uint32_t orig;
+    uint32_t dest;
+    Timestamp time;
+
+    TemporalEdge(uint32_t orig, uint32_t dest, Timestamp time)
+        : orig(orig), dest(dest), time(time) {
+        if (orig == 0U || dest == 0U) {
+            throw std::invalid_argument("vertex 0 is not valid");
+        }
+    }
+
+    [[nodiscard]] auto lt_by_orig_time(const TemporalEdge &other) const
+        -> bool {
+        if (orig != other.orig) return orig < other.orig;
+        return (time != other.time) ? time < other.time : dest < other.dest;
+    }
+};
+
+// A forward star whose arcs carry a timestamp. Each successor list is sorted
+// by time (and then by dest), with the times kept in an array parallel to
+// `edges`, so the arcs of a vertex within a time window are a contiguous slice
+// of its list, found with two binary searches over its times.
+class TemporalStarDigraph {
+    friend class temporal_bfs;
+
+   private:
+    std::vector<uint32_t> ptrs;
+    std::vector<uint32_t> edges;
+    std::vector<Timestamp> times;
+
+    // Returns the range of `edges` holding the arcs of `vertex` whose time is
+    // in `[t0, t1]`.
+    auto window(uint32_t vertex, Timestamp t0, Timestamp t1)
+        -> std::pair<uint32_t, uint32_t> {
+        const uint32_t start   = ptrs.at(vertex);
+        const size_t n         = ptrs.at(vertex + 1) - start;
+        const Timestamp *first = times.data() + start;
+        const Timestamp *lo    = branchless_lower_bound(first, n, t0);
+        const Timestamp *hi =
+            t1 == std::numeric_limits<Timestamp>::max()
+                ? first + n
+                : branchless_lower_bound(lo, first + n - lo, t1 + 1);
+        return {lo - times.data(), hi - times.data()};
+    }
+
+   public:
+    TemporalStarDigraph(uint32_t vertex_count, std::vector<TemporalEdge> arcs);
+
+    // Returns the number of vertexes in the graph.
+    auto vertexes_count() {
+        return ptrs.size() - 2;
+    }
+
+    // Returns an iterable over all the vertexes.
+    auto vertexes() {
+        return std::views::iota(1U, ptrs.size() - 1);
+    }
+
+    // Returns the successors of the given vertex, at any time, in time order.
+    auto successors(uint32_t vertex) -> std::span<const uint32_t> {
+        const uint32_t start = ptrs.at(vertex);
+        return {edges.data() + start, ptrs.at(vertex + 1) - start};
+    }
+
+    // Returns the times of the arcs in `successors(vertex)`, in the same order.
+    auto successor_times(uint32_t vertex) -> std::span<const Timestamp> {
+        const uint32_t start = ptrs.at(vertex);
+        return {times.data() + start, ptrs.at(vertex + 1) - start};
+    }
+
+    // Returns the successors of the given vertex through arcs whose time is in
+    // the closed range `[t0, t1]`, in time order. Only those arcs are touched.
+    auto successors_within(uint32_t vertex, Timestamp t0, Timestamp t1)
+        -> std::span<const uint32_t> {
+        const auto [lo, hi] = window(vertex, t0, t1);
+        return {edges.data() + lo, hi - lo};
+    }
+
+    // Hints that the neighbors of the given vertex will be needed soon, so
+    // that where they start is fetched into the cache.
+    void prefetch(uint32_t vertex) {
+        __builtin_prefetch(ptrs.data() + vertex);
+    }
+};
+
+// The digraph made of only the arcs of a `TemporalStarDigraph` whose time is
+// in the closed range `[t0, t1]`, without copying them: each successor list is
+// cut to the window when it's visited. Being an `OutNeighborGraph`, it can be
+// traversed by `dfs` and `bfs` as is.
+class TimeWindowDigraph {
+   private:
+    TemporalStarDigraph &g;
+    Timestamp t0;
+    Timestamp t1;
+
+   public:
+    TimeWindowDigraph(TemporalStarDigraph &g, Timestamp t0, Timestamp t1)
+        : g(g), t0(t0), t1(t1) {
+        if (t0 > t1) throw std::invalid_argument("invalid time window");
+    }
+
+    auto vertexes_count() {
+        return g.vertexes_count();
+    }
+
+    auto vertexes() {
+        return g.vertexes();
+    }
+
+    auto successors(uint32_t vertex) -> std::span<const uint32_t> {
+        return g.successors_within(vertex, t0, t1);
+    }
+
+    void prefetch(uint32_t vertex) {
+        g.prefetch(vertex);
+    }
+};
+
+class temporal_bfs_entry {
+   public:
+    static constexpr Timestamp UNREACHED =
+        std::numeric_limits<Timestamp>::max();
+
+    // The earliest time at which the vertex can be reached.
+    Timestamp arrival = UNREACHED;
+    // The previous vertex in a path that arrives at `arrival`.
+    NodeId parent = 0;
+};
+
+class temporal_bfs_result {
+   private:
+    std::vector<temporal_bfs_entry> ctl;
+
+   public:
+    temporal_bfs_result(size_t size_hint) : ctl(size_hint) {
+    }
+
+    auto begin() -> std::vector<temporal_bfs_entry>::iterator {
+        return ctl.begin();
+    }
+
+    auto end() -> std::vector<temporal_bfs_entry>::iterator {
+        return ctl.end();
+    }
+
+    auto at_v(NodeId i) -> temporal_bfs_entry & {
+        // Star representations guarantee that indexes always start at 1.
+        return ctl.at(i - 1);
+    }
+};
+
+// Searches for time-respecting paths: sequences of arcs whose times never
+// decrease and lie in `[t0, t1]`. Finds, for each vertex, the earliest time at
+// which it can be reached from the source (which is reached at `t0`).
+//
+// It's a breadth-first search in which a vertex is enqueued again whenever a
+// path arriving earlier is found. Since lists are sorted by time, the arcs
+// that may leave a vertex reached at time `a` are a suffix of its window,
+// starting at the first arc not earlier than `a`; a vertex that is enqueued
+// again only visits the arcs between its new and its previous arrival, so each
+// arc in the window is visited at most once.
+class temporal_bfs {
+   public:
+    // Called for each arc that improves the arrival at its dest (so the last
+    // call for each vertex is for its final parent).
+    EdgeVisitor edge_visitor = NOOP_EDGE_VISITOR;
+
+    temporal_bfs() = default;
+
+    auto execute(TemporalStarDigraph &g, NodeId source, Timestamp t0,
+                 Timestamp t1) -> temporal_bfs_result;
+};
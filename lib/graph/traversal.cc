@@ -0,0 +1,18 @@
+#include "graph/traversal.hh"
+
+template auto dfs_order(ForwardStarDigraph &g, NodeId source)
+    -> generator<discovery>;
+template auto dfs_order(TransposedDigraph<ReverseStarDigraph> &g,
+                        NodeId source) -> generator<discovery>;
+template auto dfs_order(FilteredStarDigraph<ForwardStarDigraph> &g,
+                        NodeId source) -> generator<discovery>;
+template auto dfs_order(HybridStarDigraph<ForwardStarDigraph> &g,
+                        NodeId source) -> generator<discovery>;
+template auto bfs_order(ForwardStarDigraph &g, NodeId source)
+    -> generator<discovery>;
+template auto bfs_order(TransposedDigraph<ReverseStarDigraph> &g,
+                        NodeId source) -> generator<discovery>;
+template auto bfs_order(FilteredStarDigraph<ForwardStarDigraph> &g,
+                        NodeId source) -> generator<discovery>;
+template auto bfs_order(HybridStarDigraph<ForwardStarDigraph> &g,
+                        NodeId source) -> generator<discovery>;
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "graph/bitset.hh"
+#include "graph/concepts.hh"
+#include "graph/filtered.hh"
+#include "graph/generator.hh"
+#include "graph/hybrid.hh"
+#include "graph/star.hh"
+#include "graph/visitor.hh"
+
+// A vertex found by a lazy traversal, the vertex it was found from (0 for a
+// root) and its depth in the traversal tree, which, in breadth-first order, is
+// its distance from the source.
+struct discovery {
+    NodeId vertex;
+    NodeId parent;
+    uint32_t depth;
+};
+
+// Yields the vertexes of `g` in depth-first discovery order, lazily: each one
+// is found while the consumer asks for it, so the search stops wherever the
+// consumer does. Starts from `source` or, if it's 0, from every undiscovered
+// vertex in turn (as `dfs::execute` does). `g` must outlive the generator.
+// An invalid source is only reported (by throwing) once iteration starts.
+//
+// The whole state (the stack and a visited bitset) lives in the coroutine's
+// frame, so, apart from the stack growing, nothing is allocated per vertex.
+template <OutNeighborGraph G>
+auto dfs_order(G &g, NodeId source = 0) -> generator<discovery> {
+    using iterator = decltype(out_neighbors(g, NodeId{1}).begin());
+    struct frame {
+        NodeId vertex;
+        uint32_t depth;
+        iterator next;
+        iterator end;
+    };
+
+    const size_t n = vertex_count(g);
+    if (source > n || (source != 0 && !contains_vertex(g, source))) {
+        throw std::out_of_range("invalid source vertex");
+    }
+    Bitset visited(n + 1);
+    std::vector<frame> st;
+    const auto push = [&](NodeId v, uint32_t depth) {
+        auto succs = out_neighbors(g, v);
+        st.push_back({v, depth, succs.begin(), succs.end()});
+    };
+
+    const NodeId last_root = source == 0 ? n : source;
+    for (NodeId root = source == 0 ? 1 : source; root <= last_root; root++) {
+        // as in `dfs::execute`, so that both find the same roots
+        if (!contains_vertex(g, root)) continue;
+        if (visited.test_and_set(root)) continue;
+        co_yield discovery{root, 0, 0};
+        push(root, 0);
+
+        while (!st.empty()) {
+            frame &f = st.back();
+            if (f.next == f.end) {
+                st.pop_back();
+                continue;
+            }
+            const NodeId succ_v = *f.next;
+            ++f.next;
+            if (visited.test_and_set(succ_v)) continue;
+            // `f` may be invalidated by `push`, so copy what's needed first.
+            const NodeId v       = f.vertex;
+            const uint32_t depth = f.depth + 1;
+            co_yield discovery{succ_v, v, depth};
+            push(succ_v, depth);
+        }
+    }
+}
+
+// Yields the vertexes reachable from `source` in breadth-first discovery
+// order, lazily, like `dfs_order`. `g` must outlive the generator.
+template <OutNeighborGraph G>
+auto bfs_order(G &g, NodeId source) -> generator<discovery> {
+    const size_t n = vertex_count(g);
+    if (source == 0 || source > n || !contains_vertex(g, source)) {
+        throw std::out_of_range("invalid source vertex");
+    }
+    Bitset visited(n + 1);
+    // As in `bfs`, every vertex is enqueued at most once, along with its
+    // distance from the source.
+    std::vector<discovery> queue;
+    size_t head = 0;
+
+    visited.set(source);
+    queue.push_back({source, 0, 0});
+    while (head < queue.size()) {
+        const discovery d = queue[head++];
+        co_yield d;
+        for (const NodeId succ_v : out_neighbors(g, d.vertex)) {
+            if (visited.test_and_set(succ_v)) continue;
+            queue.push_back({succ_v, d.vertex, d.depth + 1});
+        }
+    }
+}
+
+// The instantiations for the representations in this library are compiled
+// once, into the library itself.
+extern template auto dfs_order(ForwardStarDigraph &g, NodeId source)
+    -> generator<discovery>;
+extern template auto dfs_order(TransposedDigraph<ReverseStarDigraph> &g,
+                               NodeId source) -> generator<discovery>;
+extern template auto dfs_order(FilteredStarDigraph<ForwardStarDigraph> &g,
+                               NodeId source) -> generator<discovery>;
+extern template auto dfs_order(HybridStarDigraph<ForwardStarDigraph> &g,
+                               NodeId source) -> generator<discovery>;
+extern template auto bfs_order(ForwardStarDigraph &g, NodeId source)
+    -> generator<discovery>;
+extern template auto bfs_order(TransposedDigraph<ReverseStarDigraph> &g,
+                               NodeId source) -> generator<discovery>;
+extern template auto bfs_order(FilteredStarDigraph<ForwardStarDigraph> &g,
+                               NodeId source) -> generator<discovery>;
+extern template auto bfs_order(HybridStarDigraph<ForwardStarDigraph> &g,
+                               NodeId source) -> generator<discovery>;
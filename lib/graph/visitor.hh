@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+using NodeId = uint32_t;
+
+using EdgeVisitor   = std::function<void(NodeId, NodeId)>;
+using VertexVisitor = std::function<void(NodeId)>;
+
+inline const VertexVisitor NOOP_VERTEX_VISITOR = [](NodeId v) { (void)v; };
+inline const EdgeVisitor NOOP_EDGE_VISITOR     = [](NodeId o, NodeId d) {
+    (void)o;
+    (void)d;
+};
+
+// Returns whether `visitor` is the no-op one above, so that engines may skip
+// the work whose only purpose is to feed it.
+inline auto is_noop(const EdgeVisitor &visitor) -> bool {
+    return visitor.target_type() == NOOP_EDGE_VISITOR.target_type();
+}
+
+inline auto is_noop(const VertexVisitor &visitor) -> bool {
+    return visitor.target_type() == NOOP_VERTEX_VISITOR.target_type();
+}
+
+// What a traversal should do once a visitor returns.
+enum class visit_control : uint8_t {
+    // carry on as usual
+    proceed,
+    // don't explore past the vertex (or the dest of the arc) just visited
+    skip_subtree,
+    // end the traversal right away
+    stop,
+};
+
+// A visitor that may steer the traversal with the `visit_control` it returns.
+// It can be made from any callable taking `Args`, returning either a
+// `visit_control` or nothing (which means `proceed`), so plain visitors, like
+// the no-op ones above, still work. Being made from a no-op (or from nothing)
+// leaves it empty, which engines check to skip the work only done to feed it.
+template <typename... Args>
+class ControlVisitor {
+   private:
+    std::function<visit_control(Args...)> fn;
+
+   public:
+    ControlVisitor() = default;
+
+    template <std::invocable<Args...> F>
+        requires(!std::same_as<F, ControlVisitor>)
+    ControlVisitor(F f) {
+        if constexpr (std::same_as<F, std::function<void(Args...)>>) {
+            if (!f || is_noop(f)) return;
+        }
+        if constexpr (std::is_void_v<std::invoke_result_t<F &, Args...>>) {
+            fn = [f = std::move(f)](Args... args) mutable {
+                f(args...);
+                return visit_control::proceed;
+            };
+        } else {
+            fn = std::move(f);
+        }
+    }
+
+    [[nodiscard]] auto empty() const -> bool {
+        return !fn;
+    }
+
+    auto operator()(Args... args) const -> visit_control {
+        return fn ? fn(args...) : visit_control::proceed;
+    }
+};
+
+using ControlEdgeVisitor   = ControlVisitor<NodeId, NodeId>;
+using ControlVertexVisitor = ControlVisitor<NodeId>;
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <ostream>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include "graph/bfs.hh"
+#include "graph/star.hh"
+#include "graph/traversal.hh"
+
+auto main(int argc, char **argv) -> int {
+    const int POSITIONAL_ARG_LEN = 3;
+    if (argc < POSITIONAL_ARG_LEN) {
+        std::cerr << "error: missing file name argument and source vertex\n";
+        std::cerr << "usage is: ./prog [file_name] [source] [--first N]\n";
+        return 1;
+    }
+    const std::string_view file_name(argv[1]);
+    const auto source = static_cast<NodeId>(std::stoul(std::string(argv[2])));
+
+    bool debug_mode = false;
+    bool dot_mode   = false;
+    // When set, only the first this many vertexes in BFS order are printed.
+    size_t first = 0;
+
+    int curr_arg_i = POSITIONAL_ARG_LEN;
+    while (curr_arg_i < argc) {
+        const std::string_view arg(argv[curr_arg_i++]);
+        if (arg == "--debug") {
+            debug_mode = true;
+            std::cerr << "(debug mode is on)\n";
+        } else if (arg == "--dot") {
+            dot_mode = true;
+            std::cerr << "(dot mode is on)\n";
+            continue;
+        } else if (arg == "--first" && curr_arg_i < argc) {
+            first = std::stoul(std::string(argv[curr_arg_i++]));
+        }
+    }
+
+#ifdef SANITY_CHECK
+    std::cerr << "(sanity check mode is on)\n";
+#endif
+
+    std::ifstream input{std::string(file_name)};
+    if (!input.is_open()) {
+        std::cerr << "error: failed to open file `" << file_name << "`\n";
+        return 1;
+    }
+
+    uint32_t vertex_count = 0;
+    uint32_t edge_count   = 0;
+    input >> vertex_count >> edge_count;
+    if (debug_mode)
+        std::cerr << "got (vertex_count " << vertex_count
+                  << ") and (edge_count " << edge_count << ")\n";
+
+    EdgeBag edge_bag(edge_count);
+    uint32_t e_orig = 0;
+    uint32_t e_dest = 0;
+    while (input >> e_orig >> e_dest) {
+        edge_bag.add(Edge(e_orig, e_dest));
+    }
+    // sanity check
+    if (edge_bag.size() != edge_count) {
+        std::cerr << "invalid edge count, expected " << edge_count << ", got "
+                  << edge_bag.size() << "\n";
+        return 1;
+    }
+    if (source == 0 || source > vertex_count) {
+        std::cerr << "error: invalid source vertex (" << source << ")\n";
+        return 1;
+    }
+
+    ForwardStarDigraph g(vertex_count, edge_bag);
+    if (debug_mode) g.dbg(std::cerr);
+    if (dot_mode) g.dot(std::cerr);
+
+    if (first != 0) {
+        // The search stops as soon as `first` vertexes are found.
+        std::cout << "first " << first << " vertexes from (" << source
+                  << "):\n";
+        auto found = bfs_order(g, source) | std::views::take(first);
+        for (const discovery &d : found) {
+            std::cout << "  (" << d.vertex << ") at " << d.depth << "\n";
+        }
+        return 0;
+    }
+
+    bfs bfs_executor;
+    bfs_executor.tree_edge_visitor = [](NodeId orig, NodeId dest) {
+        std::cout << "  (" << orig << " -> " << dest << ")\n";
+    };
+
+    std::cout << "tree edges:\n";
+    bfs_result bfs_res = bfs_executor.execute(g, source);
+    std::cout << "------------------------------------\n";
+
+    std::cout << "distances from vertex (" << source << "):\n";
+    for (const NodeId v : g.vertexes()) {
+        const uint32_t dist = bfs_res.at_v(v).distance;
+        if (dist == bfs_entry::UNREACHED) continue;
+        std::cout << "  (" << v << ") at " << dist << "\n";
+    }
+
+    return 0;
+}
@@ -1,199 +1,89 @@
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <ostream>
-#include <stack>
 #include <string>
+#include <vector>
 
-// XX: Make a library.
-#include "../representation-star/lib.cc"
+#include "graph/checkpoint.hh"
+#include "graph/dfs.hh"
+#include "graph/dominators.hh"
+#include "graph/filtered.hh"
+#include "graph/lca.hh"
+#include "graph/star.hh"
+#include "graph/traversal.hh"
 
-using NodeId = uint32_t;
-
-enum class digraph_edge_classification : uint8_t {
-    tree,
-    back,
-    forward,
-    cross,
-};
-
-auto operator<<(std::ostream &sink, const digraph_edge_classification &ec)
-    -> std::ostream & {
-    switch (ec) {
-        case digraph_edge_classification::tree:
-            sink << "tree";
-            break;
-        case digraph_edge_classification::back:
-            sink << "back";
-            break;
-        case digraph_edge_classification::forward:
-            sink << "forward";
-            break;
-        case digraph_edge_classification::cross:
-            sink << "cross";
-            break;
+auto classify_outgoing_edges(std::ostream &sink, ForwardStarDigraph &g,
+                             dfs_result &res, NodeId v) {
+    sink << "classification of the outgoing edges of vertex (" << v << ")\n";
+    for (const NodeId dest : g.successors(v)) {
+        sink << "  (" << v << " -> " << dest << ") is a "
+             << res.classify_edge(v, dest) << " edge\n";
     }
-    return sink;
 }
 
-class dfs_entry {
-   public:
-    size_t discovery_t = 0;
-    size_t term_t      = 0;
-    NodeId parent      = 0;
-};
-
-class dfs_result {
-   private:
-    std::vector<dfs_entry> ctl;
-
-   public:
-    dfs_result(size_t size_hint) : ctl(size_hint) {
+// Prints the tree edges in the order the search took them (which is the order
+// their dests were discovered in). They are taken from the result instead of
+// from a visitor so that a resumed search prints them all.
+void print_tree_edges(std::ostream &sink, ForwardStarDigraph &g,
+                      dfs_result &res) {
+    std::vector<NodeId> children;
+    for (const NodeId v : g.vertexes()) {
+        if (res.at_v(v).parent != 0) children.push_back(v);
     }
-
-    auto begin() -> std::vector<dfs_entry>::iterator {
-        return ctl.begin();
-    }
-
-    auto end() -> std::vector<dfs_entry>::iterator {
-        return ctl.end();
-    }
-
-    auto at_v(NodeId i) -> dfs_entry & {
-        // Since we're using the forward star representation to implement this
-        // algorithm, there is a guarantee that indexes always start at 1.
-        return ctl.at(i - 1);
-    }
-
-    auto classify_edge(NodeId orig, NodeId dest)
-        -> digraph_edge_classification {
-        auto &orig_e = at_v(orig);
-        auto &dest_e = at_v(dest);
-
-        if (orig_e.discovery_t < dest_e.discovery_t) {
-            if (dest_e.parent == orig) {
-                return digraph_edge_classification::tree;
-            }
-            return digraph_edge_classification::forward;
-        }
-
-        if (dest_e.term_t < orig_e.discovery_t) {
-            return digraph_edge_classification::forward;
-        }
-        return digraph_edge_classification::back;
+    std::sort(children.begin(), children.end(), [&](NodeId a, NodeId b) {
+        return res.at_v(a).discovery_t < res.at_v(b).discovery_t;
+    });
+    for (const NodeId v : children) {
+        sink << "  (" << res.at_v(v).parent << " -> " << v << ")\n";
     }
-};
-
-using EdgeVisitor   = std::function<void(NodeId, NodeId)>;
-using VertexVisitor = std::function<void(NodeId)>;
-
-VertexVisitor NOOP_VERTEX_VISITOR = [](NodeId v) { (void)v; };
-EdgeVisitor NOOP_EDGE_VISITOR     = [](NodeId o, NodeId d) {
-    (void)o;
-    (void)d;
-};
-
-class dfs {
-   public:
-    EdgeVisitor tree_edge_visitor    = NOOP_EDGE_VISITOR;
-    EdgeVisitor back_edge_visitor    = NOOP_EDGE_VISITOR;
-    EdgeVisitor forward_edge_visitor = NOOP_EDGE_VISITOR;
-    EdgeVisitor cross_edge_visitor   = NOOP_EDGE_VISITOR;
-    VertexVisitor vertex_visitor     = NOOP_VERTEX_VISITOR;
-
-    dfs() = default;
-
-    auto execute(ForwardStarDigraph &g) -> dfs_result {
-        dfs_result res(g.vertexes_count());
-        uint64_t time = 0;
-
-        // Stack we use for each call to `dfs_v`.
-        std::stack<NodeId> st;
-
-        auto it = g.vertexes();
-        for (const NodeId v : it) {
-            // Skip if we find a vertex which is not yet discovered.
-            if (res.at_v(v).discovery_t != 0U) continue;
-
-#ifdef SANITY_CHECK
-            // Sanity check: assert that the stack is empty.
-            if (!st.empty()) throw std::logic_error("stack not empty");
-#endif
+}
 
-            dfs_v(g, st, time, res, v);
-        }
+// Searches for a path from `from` to `to`, stopping as soon as `to` is found.
+void print_path(std::ostream &sink, ForwardStarDigraph &g, NodeId from,
+                NodeId to) {
+    size_t explored = 0;
+    dfs dfs_executor;
+    dfs_executor.vertex_visitor = [&](NodeId v) {
+        explored++;
+        return v == to ? visit_control::stop : visit_control::proceed;
+    };
+    dfs_result dfs_res = dfs_executor.execute(g, from);
 
-        return res;
+    if (dfs_res.at_v(to).discovery_t == 0) {
+        sink << "no path from (" << from << ") to (" << to << ")\n";
+    } else {
+        sink << "path from (" << from << ") to (" << to << "):";
+        for (const NodeId v : dfs_res.path_to(to)) sink << " (" << v << ")";
+        sink << "\n";
     }
+    sink << "explored " << explored << " of " << g.vertexes_count()
+         << " vertexes\n";
+}
 
-   private:
-    void dfs_v(ForwardStarDigraph &g, std::stack<NodeId> &st, uint64_t &time,
-               dfs_result &res, NodeId starting_vertex) const {
-        st.push(starting_vertex);
-
-    st_loop:
-        while (!st.empty()) {
-            // Notice that we don't yet remove the vertex from the stack; we do
-            // so only after all of its children are processed.
-            const NodeId v     = st.top();
-            dfs_entry &v_entry = res.at_v(v);
-
-            // Registers the current vertex as discovered.
-            auto &v_dt = res.at_v(v).discovery_t;
-            if (v_dt == 0) {
-                res.at_v(v).discovery_t = ++time;
-                vertex_visitor(v);
-            }
-
-            for (const NodeId succ_v : g.successors(v)) {
-                dfs_entry &succ_entry = res.at_v(succ_v);
-
-                // We have just discovered `succ_v`.
-                if (succ_entry.discovery_t == 0) {
-                    tree_edge_visitor(v, succ_v);
-                    succ_entry.parent = v;
-                    st.push(succ_v);
-
-                    // XX: This is sub-optimal since, contrary to recursive
-                    // calls, which would resume AFTER the call, a naive
-                    // iterative implementation, such as this one, would have to
-                    // re-scan ALL of the **already** visited vertexes to resume
-                    // where it had stopped to recurse.
-                    //
-                    // Maybe a way to fix this problem is to save in the stack,
-                    // next to the NodeId, the index of the current iterator
-                    // pointer to resume (instead of always starting from the
-                    // beginning, as `g.successors(v)` does).
-                    goto st_loop;
-                } else {
-                    // The dest `succ_v` is ancestral and isn't yet finished.
-                    if (succ_entry.term_t == 0) {
-                        back_edge_visitor(v, succ_v);
-                    }
-                    // The origin `v` is discovered before the dest `succ_v`.
-                    else if (v_entry.discovery_t < succ_entry.discovery_t) {
-                        forward_edge_visitor(v, succ_v);
-                    }
-                    // The origin `v` is discovered after the dest `succ_v`.
-                    else {
-                        cross_edge_visitor(v, succ_v);
-                    }
-                }
-            }
-
-            st.pop();
-            v_entry.term_t = ++time;
-        }
-    }
-};
+// Searches `g` as if the `hidden` vertexes (and their arcs) weren't there,
+// printing the discovery order found by the engine and by the lazy traversal,
+// which must agree.
+void print_without(std::ostream &sink, ForwardStarDigraph &g,
+                   const std::vector<NodeId> &hidden) {
+    Bitset vertex_mask(g.vertexes_count() + 1, true);
+    for (const NodeId v : hidden) vertex_mask.reset(v);
+    FilteredStarDigraph view(g, &vertex_mask, nullptr);
 
-auto classify_outgoing_edges(std::ostream &sink, ForwardStarDigraph &g,
-                             dfs_result &res, NodeId v) {
-    sink << "classification of the outgoing edges of vertex (" << v << ")\n";
-    for (const NodeId dest : g.successors(v)) {
-        sink << "  (" << v << " -> " << dest << ") is a "
-             << res.classify_edge(v, dest) << " edge\n";
-    }
+    std::vector<NodeId> order;
+    dfs dfs_executor;
+    dfs_executor.vertex_visitor = [&](NodeId v) { order.push_back(v); };
+    dfs_executor.execute(view);
+    sink << "discovery order:";
+    for (const NodeId v : order) sink << " (" << v << ")";
+    sink << "\n";
+
+    sink << "lazy discovery order:";
+    for (const discovery &d : dfs_order(view)) sink << " (" << d.vertex << ")";
+    sink << "\n";
 }
 
 auto main(int argc, char **argv) -> int {
@@ -204,6 +94,17 @@ auto main(int argc, char **argv) -> int {
         std::cerr << "usage is: ./prog [file_name] [vertex]\n";
         std::cerr << "  (pass \"ALL\" in the [vertex] argument to classify all "
                      "vertexes' outgoing edges.)\n";
+        std::cerr << "  (pass \"--checkpoint [file]\" to save the search "
+                     "state every \"--checkpoint-every [arcs]\" arcs, and "
+                     "\"--resume\" to continue from it.)\n";
+        std::cerr << "  (pass \"--path [from] [to]\" to only look for a path "
+                     "between two vertexes, or \"--lca [u] [v]\" to only find "
+                     "their lowest common ancestor.)\n";
+        std::cerr << "  (pass \"--idom [entry]\" to only find the immediate "
+                     "dominators of the vertexes reachable from [entry].)\n";
+        std::cerr << "  (pass \"--hide [vertex]\", any number of times, to "
+                     "only print the discovery order without those "
+                     "vertexes.)\n";
         return 1;
     }
     const std::string_view file_name(argv[1]);
@@ -216,6 +117,15 @@ auto main(int argc, char **argv) -> int {
 
     bool debug_mode = false;
     bool dot_mode   = false;
+    bool resume     = false;
+    std::string checkpoint_file;
+    uint64_t checkpoint_every = dfs::DEFAULT_CHECKPOINT_INTERVAL;
+    NodeId path_from          = 0;
+    NodeId path_to            = 0;
+    NodeId lca_u              = 0;
+    NodeId lca_v              = 0;
+    NodeId idom_entry         = 0;
+    std::vector<NodeId> hidden;
 
     int curr_arg_i = POSITIONAL_ARG_LEN;
     while (curr_arg_i < argc) {
@@ -227,14 +137,42 @@ auto main(int argc, char **argv) -> int {
             dot_mode = true;
             std::cerr << "(dot mode is on)\n";
             continue;
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if ((arg == "--checkpoint" || arg == "--checkpoint-every") &&
+                   curr_arg_i < argc) {
+            const std::string value(argv[curr_arg_i++]);
+            if (arg == "--checkpoint") {
+                checkpoint_file = value;
+            } else {
+                checkpoint_every = std::stoull(value);
+            }
+        } else if ((arg == "--path" || arg == "--lca") &&
+                   curr_arg_i + 1 < argc) {
+            NodeId &a = arg == "--path" ? path_from : lca_u;
+            NodeId &b = arg == "--path" ? path_to : lca_v;
+            a         = std::stoul(std::string(argv[curr_arg_i++]));
+            b         = std::stoul(std::string(argv[curr_arg_i++]));
+        } else if (arg == "--idom" && curr_arg_i < argc) {
+            idom_entry = std::stoul(std::string(argv[curr_arg_i++]));
+        } else if (arg == "--hide" && curr_arg_i < argc) {
+            hidden.push_back(std::stoul(std::string(argv[curr_arg_i++])));
         }
     }
+    if (resume && checkpoint_file.empty()) {
+        std::cerr << "error: --resume requires --checkpoint [file]\n";
+        return 1;
+    }
+    if (checkpoint_every == 0) {
+        std::cerr << "error: --checkpoint-every must be positive\n";
+        return 1;
+    }
 
 #ifdef SANITY_CHECK
     std::cerr << "(sanity check mode is on)\n";
 #endif
 
-    std::ifstream input(file_name);
+    std::ifstream input{std::string(file_name)};
     if (!input.is_open()) {
         std::cerr << "error: failed to open file `" << file_name << "`\n";
         return 1;
@@ -264,13 +202,80 @@ auto main(int argc, char **argv) -> int {
     if (debug_mode) g.dbg(std::cerr);
     if (dot_mode) g.dot(std::cerr);
 
+    if (!hidden.empty()) {
+        for (const NodeId v : hidden) {
+            if (v == 0 || v > vertex_count) {
+                std::cerr << "error: invalid --hide vertex\n";
+                return 1;
+            }
+        }
+        print_without(std::cout, g, hidden);
+        return 0;
+    }
+    if (path_from != 0) {
+        if (path_from > vertex_count || path_to == 0 ||
+            path_to > vertex_count) {
+            std::cerr << "error: invalid --path vertexes\n";
+            return 1;
+        }
+        print_path(std::cout, g, path_from, path_to);
+        return 0;
+    }
+    if (idom_entry != 0) {
+        if (idom_entry > vertex_count) {
+            std::cerr << "error: invalid --idom vertex\n";
+            return 1;
+        }
+        ReverseStarDigraph rev = transpose(g);
+        const std::vector<NodeId> idom =
+            immediate_dominators(g, rev, idom_entry);
+        std::cout << "immediate dominators from (" << idom_entry << "):\n";
+        for (const NodeId v : g.vertexes()) {
+            if (idom[v] == 0 || v == idom_entry) continue;
+            std::cout << "  (" << v << ") by (" << idom[v] << ")\n";
+        }
+        return 0;
+    }
+    if (lca_u != 0) {
+        if (lca_u > vertex_count || lca_v == 0 || lca_v > vertex_count) {
+            std::cerr << "error: invalid --lca vertexes\n";
+            return 1;
+        }
+        dfs_result dfs_res = dfs().execute(g);
+        const NodeId w     = lca_index(dfs_res).lca(lca_u, lca_v);
+        std::cout << "lowest common ancestor of (" << lca_u << ") and ("
+                  << lca_v << "): ";
+        if (w == 0) {
+            std::cout << "none (they are in different trees)\n";
+        } else {
+            std::cout << "(" << w << ")\n";
+        }
+        return 0;
+    }
+
     dfs dfs_executor;
-    dfs_executor.tree_edge_visitor = [](NodeId orig, NodeId dest) {
-        std::cout << "  (" << orig << " -> " << dest << ")\n";
-    };
+    std::unique_ptr<dfs_checkpoint> checkpoint;
+    if (!checkpoint_file.empty()) {
+        try {
+            checkpoint = std::make_unique<dfs_checkpoint>(
+                checkpoint_file, g.vertexes_count(), resume);
+        } catch (const std::exception &e) {
+            std::cerr << "error: " << e.what() << "\n";
+            return 1;
+        }
+        dfs_executor.checkpoint          = checkpoint.get();
+        dfs_executor.checkpoint_interval = checkpoint_every;
+    }
+    if (resume && !checkpoint->has_state()) {
+        std::cerr << "error: checkpoint `" << checkpoint_file
+                  << "` has no saved state\n";
+        return 1;
+    }
 
+    dfs_result dfs_res =
+        resume ? dfs_executor.resume(g) : dfs_executor.execute(g);
     std::cout << "tree edges:\n";
-    dfs_result dfs_res = dfs_executor.execute(g);
+    print_tree_edges(std::cout, g, dfs_res);
     std::cout << "------------------------------------\n";
 
     // We could also have used the visitor APIs to implement this
@@ -0,0 +1,603 @@
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "graph/bfs.hh"
+#include "graph/bitset.hh"
+#include "graph/dfs.hh"
+#include "graph/star.hh"
+#include "graph/static.hh"
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the compiler from optimizing away the benchmarked loops.
+volatile uint64_t sink = 0;
+
+// Makes the compiler assume that `value` may have changed, so that work that
+// depends on it isn't hoisted out of the benchmarked loops.
+template <typename T>
+void clobber(T &value) {
+    asm volatile("" : "+m"(value));
+}
+
+auto ms_since(Clock::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+        .count();
+}
+
+// Counts the cache misses (as the last level cache sees them) of the calling
+// thread, through `perf_event_open`. Kernels may not allow it (as is often the
+// case in containers), in which case `available` is false.
+class MissCounter {
+   private:
+    int fd = -1;
+
+   public:
+    MissCounter() {
+        perf_event_attr attr{};
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof(attr);
+        attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        fd                  = static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    MissCounter(const MissCounter &)                     = delete;
+    auto operator=(const MissCounter &) -> MissCounter & = delete;
+
+    ~MissCounter() {
+        if (fd >= 0) close(fd);
+    }
+
+    [[nodiscard]] auto available() const -> bool {
+        return fd >= 0;
+    }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    auto stop() -> uint64_t {
+        uint64_t count = 0;
+        if (fd < 0) return count;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+        return count;
+    }
+};
+
+// Generates `edge_count` uniformly random arcs over `vertex_count` vertexes.
+auto random_arcs(uint32_t vertex_count, size_t edge_count, uint64_t seed)
+    -> std::vector<std::pair<uint32_t, uint32_t>> {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<uint32_t> vertex(1, vertex_count);
+    std::vector<std::pair<uint32_t, uint32_t>> arcs(edge_count);
+    for (auto &[orig, dest] : arcs) {
+        orig = vertex(rng);
+        dest = vertex(rng);
+    }
+    return arcs;
+}
+
+// Iterates over the set bits of a range of words, yielding their indexes.
+class BitsIterable {
+   public:
+    class iterator {
+        friend class BitsIterable;
+
+       private:
+        const uint64_t *words = nullptr;
+        size_t word_i         = 0;
+        size_t words_count    = 0;
+        uint64_t word         = 0;
+
+        void skip_empty_words() {
+            while (word == 0 && ++word_i < words_count) word = words[word_i];
+        }
+
+       public:
+        auto operator*() const -> uint32_t {
+            return word_i * Bitset::WORD_BITS + std::countr_zero(word);
+        }
+
+        auto operator++() -> iterator & {
+            word &= word - 1;
+            skip_empty_words();
+            return *this;
+        }
+
+        auto operator==(const iterator &other) const -> bool {
+            return word_i == other.word_i && word == other.word;
+        }
+    };
+
+   private:
+    iterator _begin;
+    iterator _end;
+
+   public:
+    BitsIterable(const uint64_t *words, size_t words_count) {
+        _begin.words = _end.words = words;
+        _begin.words_count = _end.words_count = words_count;
+        _end.word_i                           = words_count;
+        if (words_count != 0) {
+            _begin.word = words[0];
+            _begin.skip_empty_words();
+        }
+    }
+
+    [[nodiscard]] auto begin() const -> iterator {
+        return _begin;
+    }
+
+    [[nodiscard]] auto end() const -> iterator {
+        return _end;
+    }
+};
+
+// The adjacency matrix, as one bit per (orig, dest) pair. Rows are padded to
+// whole words, so that they may be scanned a word at a time.
+class BitMatrix {
+   private:
+    size_t row_words;
+    Bitset bits;
+
+   public:
+    BitMatrix(uint32_t vertex_count)
+        : row_words((vertex_count + Bitset::WORD_BITS) / Bitset::WORD_BITS),
+          bits(row_words * Bitset::WORD_BITS * (vertex_count + 1)) {
+    }
+
+    void add(uint32_t orig, uint32_t dest) {
+        bits.set(orig * row_words * Bitset::WORD_BITS + dest);
+    }
+
+    // Returns the successors of `vertex`, found by scanning its whole row.
+    [[nodiscard]] auto successors(uint32_t vertex) const -> BitsIterable {
+        return {bits.data() + vertex * row_words, row_words};
+    }
+
+    // Returns the `k`-th successor of `vertex`, or 0 if there is none.
+    [[nodiscard]] auto kth_successor(uint32_t vertex, uint32_t k) const
+        -> uint32_t {
+        const uint64_t *row = bits.data() + vertex * row_words;
+        for (size_t i = 0; i < row_words; i++) {
+            uint64_t word         = row[i];
+            const uint32_t in_row = std::popcount(word);
+            if (k >= in_row) {
+                k -= in_row;
+                continue;
+            }
+            while (k-- > 0) word &= word - 1;
+            return i * Bitset::WORD_BITS + std::countr_zero(word);
+        }
+        return 0;
+    }
+
+    [[nodiscard]] auto bytes() const -> size_t {
+        return bits.words_count() * sizeof(uint64_t);
+    }
+};
+
+// Runs a full DFS (from every undiscovered vertex), getting the neighbors of a
+// vertex through `successors`. Returns the number of tree edges.
+template <typename F>
+auto dfs_all(uint32_t vertex_count, F successors) -> uint64_t {
+    using Range = decltype(successors(1U));
+    using Iter  = decltype(std::declval<Range &>().begin());
+    struct frame {
+        Range range;
+        Iter it;
+    };
+
+    std::vector<bool> discovered(vertex_count + 1);
+    std::vector<frame> st;
+    uint64_t tree_edges = 0;
+    for (uint32_t root = 1; root <= vertex_count; root++) {
+        if (discovered[root]) continue;
+        discovered[root] = true;
+        st.push_back({successors(root), {}});
+        st.back().it = st.back().range.begin();
+        while (!st.empty()) {
+            frame &f = st.back();
+            if (f.it == f.range.end()) {
+                st.pop_back();
+                continue;
+            }
+            const uint32_t v = *f.it;
+            ++f.it;
+            if (discovered[v]) continue;
+            discovered[v] = true;
+            tree_edges++;
+            st.push_back({successors(v), {}});
+            st.back().it = st.back().range.begin();
+        }
+    }
+    return tree_edges;
+}
+
+struct measurement {
+    double build_ms;
+    size_t bytes;
+    double scan_medges_s;
+    double random_ns;
+    double dfs_ms;
+};
+
+const size_t RANDOM_QUERIES = 1U << 18U;
+
+// Measures a representation, given how to `build` it, to get its size in
+// `bytes`, to get the `kth` successor of a vertex and to `scan` all of its
+// arcs (returning a checksum), and to run a DFS over it.
+template <typename Build, typename Bytes, typename Kth, typename Scan,
+          typename Dfs>
+auto measure(uint32_t vertex_count, size_t edge_count,
+             const std::vector<uint32_t> &outdegrees, Build build, Bytes bytes,
+             Kth kth, Scan scan, Dfs dfs) -> measurement {
+    measurement m{};
+
+    auto start = Clock::now();
+    auto repr  = build();
+    m.build_ms = ms_since(start);
+    m.bytes    = bytes(repr);
+
+    start = Clock::now();
+    sink  = sink + scan(repr);
+    m.scan_medges_s =
+        static_cast<double>(edge_count) / ms_since(start) / 1000.0;
+
+    // the queries are drawn beforehand, so that only the access is timed
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint32_t> vertex(1, vertex_count);
+    std::vector<std::pair<uint32_t, uint32_t>> queries;
+    queries.reserve(RANDOM_QUERIES);
+    while (queries.size() < RANDOM_QUERIES) {
+        const uint32_t v = vertex(rng);
+        if (outdegrees[v] == 0) continue;
+        queries.emplace_back(v, rng() % outdegrees[v]);
+    }
+    start          = Clock::now();
+    uint64_t check = 0;
+    for (const auto &[v, k] : queries) check += kth(repr, v, k);
+    sink        = sink + check;
+    m.random_ns = ms_since(start) * 1e6 / static_cast<double>(queries.size());
+
+    start    = Clock::now();
+    sink     = sink + dfs(repr);
+    m.dfs_ms = ms_since(start);
+    return m;
+}
+
+void print_row(uint32_t vertex_count, size_t edge_count, const char *name,
+               const measurement &m) {
+    std::cout << "| " << std::setw(7) << vertex_count << " | " << std::setw(8)
+              << edge_count << " | " << std::setw(11) << name << " | "
+              << std::setw(9) << m.build_ms << " | " << std::setw(9)
+              << static_cast<double>(m.bytes) / (1U << 20U) << " | "
+              << std::setw(12) << m.scan_medges_s << " | " << std::setw(9)
+              << m.random_ns << " | " << std::setw(9) << m.dfs_ms << " |\n";
+}
+
+void bench(uint32_t vertex_count, size_t edge_count, size_t matrix_limit) {
+    const auto arcs = random_arcs(vertex_count, edge_count, vertex_count);
+    std::vector<uint32_t> outdegrees(vertex_count + 1);
+    for (const auto &arc : arcs) outdegrees[arc.first]++;
+
+    // forward star
+    print_row(
+        vertex_count, edge_count, "fwd star",
+        measure(
+            vertex_count, edge_count, outdegrees,
+            [&] {
+                EdgeBag edge_bag(arcs.size());
+                for (const auto &[o, d] : arcs) edge_bag.add(Edge(o, d));
+                return ForwardStarDigraph(vertex_count, edge_bag);
+            },
+            [&](ForwardStarDigraph &) {
+                // ptrs and edges, each with one unused element
+                return (vertex_count + 2 + edge_count + 1) * sizeof(uint32_t);
+            },
+            [](ForwardStarDigraph &g, uint32_t v, uint32_t k) {
+                return *(g.successors(v).begin() + k);
+            },
+            [](ForwardStarDigraph &g) {
+                uint64_t sum = 0;
+                for (const uint32_t v : g.vertexes()) {
+                    for (const uint32_t s : g.successors(v)) sum += s;
+                }
+                return sum;
+            },
+            [&](ForwardStarDigraph &g) {
+                return dfs_all(vertex_count,
+                               [&](uint32_t v) { return g.successors(v); });
+            }));
+
+    // adjacency list
+    using AdjList = std::vector<std::vector<uint32_t>>;
+    print_row(
+        vertex_count, edge_count, "adj list",
+        measure(
+            vertex_count, edge_count, outdegrees,
+            [&] {
+                AdjList g(vertex_count + 1);
+                for (const auto &[o, d] : arcs) g[o].push_back(d);
+                return g;
+            },
+            [](AdjList &g) {
+                // not counting the allocator's own per-block overhead
+                size_t total = g.capacity() * sizeof(std::vector<uint32_t>);
+                for (const auto &succs : g) {
+                    total += succs.capacity() * sizeof(uint32_t);
+                }
+                return total;
+            },
+            [](AdjList &g, uint32_t v, uint32_t k) { return g[v][k]; },
+            [](AdjList &g) {
+                uint64_t sum = 0;
+                for (const auto &succs : g) {
+                    for (const uint32_t s : succs) sum += s;
+                }
+                return sum;
+            },
+            [&](AdjList &g) {
+                return dfs_all(vertex_count, [&](uint32_t v) {
+                    return std::ranges::ref_view(g[v]);
+                });
+            }));
+
+    // adjacency matrix
+    const size_t matrix_bytes =
+        static_cast<size_t>(vertex_count + 1) * (vertex_count + 1) / 8;
+    if (matrix_bytes > matrix_limit) {
+        std::cout << "| " << std::setw(7) << vertex_count << " | "
+                  << std::setw(8) << edge_count << " | " << std::setw(11)
+                  << "adj matrix"
+                  << " | (skipped: would take "
+                  << matrix_bytes / (1U << 20U) << " MiB)\n";
+        return;
+    }
+    print_row(
+        vertex_count, edge_count, "adj matrix",
+        measure(
+            vertex_count, edge_count, outdegrees,
+            [&] {
+                BitMatrix g(vertex_count);
+                for (const auto &[o, d] : arcs) g.add(o, d);
+                return g;
+            },
+            [](BitMatrix &g) { return g.bytes(); },
+            [](BitMatrix &g, uint32_t v, uint32_t k) {
+                return g.kth_successor(v, k);
+            },
+            [&](BitMatrix &g) {
+                uint64_t sum = 0;
+                for (uint32_t v = 1; v <= vertex_count; v++) {
+                    for (const uint32_t s : g.successors(v)) sum += s;
+                }
+                return sum;
+            },
+            [&](BitMatrix &g) {
+                return dfs_all(vertex_count,
+                               [&](uint32_t v) { return g.successors(v); });
+            }));
+}
+
+const uint32_t PREFETCH_DISTANCES[] = {0, 1, 2, 4, 8, 16};
+
+// Runs the library's DFS and BFS over a random forward star with each of the
+// `PREFETCH_DISTANCES`, reporting the time and the cache misses per visited
+// arc of each run, and which distance was the fastest for each engine.
+void bench_prefetch(uint32_t vertex_count, size_t edge_count) {
+    const auto arcs = random_arcs(vertex_count, edge_count, vertex_count);
+    EdgeBag edge_bag(arcs.size());
+    for (const auto &[o, d] : arcs) edge_bag.add(Edge(o, d));
+    ForwardStarDigraph g(vertex_count, edge_bag);
+
+    MissCounter misses;
+    if (!misses.available()) {
+        std::cerr << "(cache misses are not available: perf_event_open "
+                     "failed)\n";
+    }
+    const auto report = [&](const char *engine, uint32_t distance,
+                            double ms, uint64_t miss_count, size_t arcs) {
+        std::cout << "| " << std::setw(7) << vertex_count << " | "
+                  << std::setw(8) << edge_count << " | " << std::setw(6)
+                  << engine << " | " << std::setw(8) << distance << " | "
+                  << std::setw(9) << ms << " | ";
+        if (misses.available()) {
+            std::cout << std::setw(10)
+                      << static_cast<double>(miss_count) /
+                             static_cast<double>(arcs);
+        } else {
+            std::cout << std::setw(10) << "n/a";
+        }
+        std::cout << " |\n";
+    };
+
+    std::pair<uint32_t, double> best_dfs{0, 0.0};
+    std::pair<uint32_t, double> best_bfs{0, 0.0};
+    for (const uint32_t distance : PREFETCH_DISTANCES) {
+        dfs dfs_executor;
+        dfs_executor.prefetch_distance = distance;
+        auto start                     = Clock::now();
+        misses.start();
+        dfs_result dfs_res      = dfs_executor.execute(g);
+        const uint64_t dfs_miss = misses.stop();
+        const double dfs_ms     = ms_since(start);
+        sink = sink + dfs_res.at_v(vertex_count).discovery_t;
+        report("dfs", distance, dfs_ms, dfs_miss, edge_count);
+        if (best_dfs.second == 0.0 || dfs_ms < best_dfs.second) {
+            best_dfs = {distance, dfs_ms};
+        }
+
+        bfs bfs_executor;
+        bfs_executor.prefetch_distance = distance;
+        start                          = Clock::now();
+        misses.start();
+        bfs_result bfs_res      = bfs_executor.execute(g, 1);
+        const uint64_t bfs_miss = misses.stop();
+        const double bfs_ms     = ms_since(start);
+        size_t bfs_arcs         = 0;
+        for (const uint32_t v : g.vertexes()) {
+            if (bfs_res.at_v(v).distance != bfs_entry::UNREACHED) {
+                bfs_arcs += g.outdegree(v);
+            }
+        }
+        report("bfs", distance, bfs_ms, bfs_miss,
+               std::max<size_t>(bfs_arcs, 1));
+        if (best_bfs.second == 0.0 || bfs_ms < best_bfs.second) {
+            best_bfs = {distance, bfs_ms};
+        }
+    }
+    std::cout << "\nfastest prefetch distance: dfs " << best_dfs.first
+              << ", bfs " << best_bfs.first << "\n";
+}
+
+// `inputs/representation/graph-test-5.txt`, built at compile time.
+constexpr auto GRAPH_TEST_5 = make_static_forward_star<5>(std::array{
+    std::pair{3U, 4U}, std::pair{4U, 5U}, std::pair{1U, 3U}, std::pair{2U, 4U},
+    std::pair{5U, 2U}, std::pair{1U, 2U}, std::pair{3U, 2U}});
+constexpr auto GRAPH_TEST_5_DFS = static_dfs(GRAPH_TEST_5);
+constexpr auto GRAPH_TEST_5_BFS = static_bfs(GRAPH_TEST_5, 1);
+
+// Both traversals are fully evaluated by the compiler, so a wrong order is a
+// build error.
+static_assert(GRAPH_TEST_5_DFS.order == std::array{1U, 2U, 4U, 5U, 3U});
+static_assert(GRAPH_TEST_5_DFS.parent ==
+              std::array{0U, 0U, 1U, 1U, 2U, 4U});
+static_assert(GRAPH_TEST_5_BFS.order == std::array{1U, 2U, 3U, 4U, 5U});
+static_assert(GRAPH_TEST_5_BFS.parent ==
+              std::array{0U, 0U, 1U, 1U, 2U, 4U});
+
+// Runs a full DFS over `GRAPH_TEST_5` `runs` times in each of the ways it can
+// be done: with the library's engine over a `ForwardStarDigraph` and over the
+// static graph itself, with `static_dfs` (whose stack is an array) and with
+// the precomputed traversal unrolled into straight-line visitor calls.
+void bench_constant(size_t runs) {
+    EdgeBag edge_bag(GRAPH_TEST_5.EDGES);
+    for (const uint32_t v : GRAPH_TEST_5.vertexes()) {
+        for (const uint32_t s : GRAPH_TEST_5.successors(v)) {
+            edge_bag.add(Edge(v, s));
+        }
+    }
+    ForwardStarDigraph heap_g(GRAPH_TEST_5.VERTEXES, edge_bag);
+    auto static_g = GRAPH_TEST_5;
+
+    const auto report = [&](const char *engine, const char *repr,
+                            Clock::time_point start) {
+        std::cout << "| " << std::setw(10) << engine << " | " << std::setw(12)
+                  << repr << " | " << std::setw(8)
+                  << ms_since(start) * 1e6 / static_cast<double>(runs)
+                  << " |\n";
+    };
+
+    dfs dfs_executor;
+    auto start = Clock::now();
+    for (size_t i = 0; i < runs; i++) {
+        clobber(heap_g);
+        sink = sink + dfs_executor.execute(heap_g).at_v(3).parent;
+    }
+    report("dfs", "forward star", start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < runs; i++) {
+        clobber(static_g);
+        sink = sink + dfs_executor.execute(static_g).at_v(3).parent;
+    }
+    report("dfs", "static", start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < runs; i++) {
+        clobber(static_g);
+        sink = sink + static_dfs(static_g).parent[3];
+    }
+    report("static_dfs", "static", start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < runs; i++) {
+        uint64_t sum = 0;
+        unroll_traversal<GRAPH_TEST_5_DFS>(
+            [&](auto... vertexes) { sum += (vertexes + ...); });
+        sink = sink + sum;
+    }
+    report("unrolled", "static", start);
+}
+
+auto main(int argc, char **argv) -> int {
+    uint32_t max_vertexes      = 100000;
+    size_t matrix_limit        = 256U << 20U;
+    uint32_t prefetch_vertexes = 1000000;
+    size_t constant_runs       = 1000000;
+
+    int curr_arg_i = 1;
+    while (curr_arg_i < argc) {
+        const std::string_view arg(argv[curr_arg_i++]);
+        if (arg == "--max-vertexes" && curr_arg_i < argc) {
+            max_vertexes = std::stoul(argv[curr_arg_i++]);
+        } else if (arg == "--matrix-limit-mb" && curr_arg_i < argc) {
+            matrix_limit = std::stoul(argv[curr_arg_i++]) << 20U;
+        } else if (arg == "--prefetch-vertexes" && curr_arg_i < argc) {
+            prefetch_vertexes = std::stoul(argv[curr_arg_i++]);
+        } else if (arg == "--constant-runs" && curr_arg_i < argc) {
+            constant_runs = std::stoul(argv[curr_arg_i++]);
+        } else {
+            std::cerr << "error: unknown argument `" << arg << "`\n";
+            std::cerr << "usage is: ./prog [--max-vertexes N] "
+                         "[--matrix-limit-mb N] [--prefetch-vertexes N] "
+                         "[--constant-runs N]\n";
+            return 1;
+        }
+    }
+
+#ifdef SANITY_CHECK
+    std::cerr << "(sanity check mode is on)\n";
+#endif
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "|       V |        E |        repr |  build ms |       MiB "
+                 "| scan Medge/s | rand ns/q |    dfs ms |\n";
+    std::cout << "|--------:|---------:|------------:|----------:|----------:"
+                 "|-------------:|----------:|----------:|\n";
+    // 20 arcs per vertex is the density of the README's exercise graph
+    for (const uint32_t vertex_count : {1000U, 10000U, 50000U, 100000U}) {
+        if (vertex_count > max_vertexes) break;
+        for (const size_t avg_degree : {2U, 20U, 100U}) {
+            bench(vertex_count, avg_degree * vertex_count, matrix_limit);
+        }
+    }
+
+    // the prefetch distance only matters once the graph is past the caches
+    if (prefetch_vertexes != 0) {
+        std::cout << "\n";
+        std::cout << "|       V |        E | engine | distance |        ms "
+                     "| misses/arc |\n";
+        std::cout << "|--------:|---------:|-------:|---------:|----------:"
+                     "|-----------:|\n";
+        bench_prefetch(prefetch_vertexes, 8 * size_t{prefetch_vertexes});
+    }
+
+    if (constant_runs != 0) {
+        std::cout << "\n";
+        std::cout << "|     engine |         repr |   ns/run |\n";
+        std::cout << "|-----------:|-------------:|---------:|\n";
+        bench_constant(constant_runs);
+    }
+
+    return 0;
+}
@@ -1,10 +1,98 @@
 #include <stdint.h>
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <string>
 
-#include "./lib.cc"
+#include "graph/bidirectional.hh"
+#include "graph/closure.hh"
+#include "graph/dag.hh"
+#include "graph/scc.hh"
+#include "graph/star.hh"
+#include "graph/summary.hh"
+
+void print_summary(std::ostream &sink, const graph_summary &s) {
+    sink << "vertexes: " << s.vertexes << "\n";
+    sink << "arcs: " << s.arcs << "\n";
+    sink << "----------------\n";
+    sink << std::fixed << std::setprecision(2);
+    sink << "           " << std::setw(10) << "min" << std::setw(10) << "max"
+         << std::setw(10) << "mean" << std::setw(10) << "median"
+         << std::setw(10) << "zeros" << "\n";
+    for (const auto &[name, d] : {std::pair{"outdegree", &s.out},
+                                  std::pair{"indegree ", &s.in}}) {
+        sink << "  " << name << std::setw(10) << d->min << std::setw(10)
+             << d->max << std::setw(10) << d->mean << std::setw(10)
+             << d->median << std::setw(10) << d->zeros << "\n";
+    }
+    sink << "----------------\n";
+    sink << "degree histogram (log2 buckets):\n";
+    sink << "  " << std::setw(24) << "degrees" << std::setw(12) << "out"
+         << std::setw(12) << "in" << "\n";
+    for (size_t b = 0; b < DEGREE_BUCKETS; b++) {
+        if (s.out.histogram[b] == 0 && s.in.histogram[b] == 0) continue;
+        const uint64_t lo = b == 0 ? 0 : 1ULL << (b - 1);
+        const uint64_t hi = b == 0 ? 0 : (1ULL << b) - 1;
+        sink << "  " << std::setw(24)
+             << ("[" + std::to_string(lo) + ", " + std::to_string(hi) + "]")
+             << std::setw(12) << s.out.histogram[b] << std::setw(12)
+             << s.in.histogram[b] << "\n";
+    }
+    sink << "----------------\n";
+    sink << "self-loops: " << s.self_loops << "\n";
+    sink << "duplicate arcs: " << s.duplicate_arcs << "\n";
+    sink << "reciprocity: " << std::setprecision(4) << s.reciprocity() << " ("
+         << s.reciprocal_arcs << " of " << s.distinct_arcs
+         << " distinct arcs)\n";
+}
+
+void print_critical_path(std::ostream &sink, const critical_path_result &r) {
+    sink << "levels: " << r.levels << "\n";
+    sink << "critical path length: " << r.length << "\n";
+    sink << "critical path:";
+    for (const NodeId v : r.critical_path) sink << " (" << v << ")";
+    sink << "\n";
+}
+
+void print_reduction(std::ostream &sink, ForwardStarDigraph &g) {
+    const auto arcs_of = [](ForwardStarDigraph &h) {
+        size_t arcs = 0;
+        for (const uint32_t v : h.vertexes()) arcs += h.outdegree(v);
+        return arcs;
+    };
+    const scc_result scc       = strongly_connected_components(g);
+    ForwardStarDigraph reduced = transitive_reduction(g, scc);
+    sink << "strongly connected components: " << scc.count << "\n";
+    sink << "arcs: " << arcs_of(g) << " -> " << arcs_of(reduced) << "\n";
+}
+
+// Computes the transitive closure of `g` into `file`, reporting upfront how
+// much memory it may take, and answers whether `u` reaches `v`, if given.
+auto print_closure(std::ostream &sink, ForwardStarDigraph &g,
+                   const std::string &file, NodeId u, NodeId v) -> int {
+    const size_t n = g.vertexes_count();
+    if ((u != 0 || v != 0) && (u == 0 || v == 0 || u > n || v > n)) {
+        std::cerr << "error: invalid --reaches vertexes\n";
+        return 1;
+    }
+    sink << "closure may take " << transitive_closure::bytes_for(n)
+         << " bytes (limit is " << DEFAULT_CLOSURE_LIMIT << ")\n";
+    try {
+        const transitive_closure closure(g, DEFAULT_CLOSURE_LIMIT, file);
+        sink << "components: " << closure.components_count() << "\n";
+        sink << "closure takes " << closure.size_bytes() << " bytes, in `"
+             << file << "`\n";
+        if (u != 0) {
+            sink << "(" << u << ") reaches (" << v
+                 << "): " << (closure.reaches(u, v) ? "yes" : "no") << "\n";
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
 
 auto main(int argc, char **argv) -> int {
     if (argc < 2) {
@@ -13,8 +101,14 @@ auto main(int argc, char **argv) -> int {
     }
     const std::string_view file_name(argv[1]);
 
-    bool debug_mode = false;
-    bool dot_mode   = false;
+    bool debug_mode    = false;
+    bool dot_mode      = false;
+    bool summary_mode  = false;
+    bool critical_mode = false;
+    bool reduce_mode   = false;
+    std::string closure_file;
+    NodeId reaches_u = 0;
+    NodeId reaches_v = 0;
 
     int curr_arg_i = 2;
     while (curr_arg_i < argc) {
@@ -26,6 +120,17 @@ auto main(int argc, char **argv) -> int {
             dot_mode = true;
             std::cerr << "(dot mode is on)\n";
             continue;
+        } else if (arg == "--summary") {
+            summary_mode = true;
+        } else if (arg == "--critical-path") {
+            critical_mode = true;
+        } else if (arg == "--transitive-reduction") {
+            reduce_mode = true;
+        } else if (arg == "--closure" && curr_arg_i < argc) {
+            closure_file = argv[curr_arg_i++];
+        } else if (arg == "--reaches" && curr_arg_i + 1 < argc) {
+            reaches_u = std::stoul(std::string(argv[curr_arg_i++]));
+            reaches_v = std::stoul(std::string(argv[curr_arg_i++]));
         }
     }
 
@@ -33,7 +138,7 @@ auto main(int argc, char **argv) -> int {
     std::cerr << "(sanity check mode is on)\n";
 #endif
 
-    std::ifstream input(file_name);
+    std::ifstream input{std::string(file_name)};
     if (!input.is_open()) {
         std::cerr << "error: failed to open file `" << file_name << "`\n";
         return 1;
@@ -59,10 +164,35 @@ auto main(int argc, char **argv) -> int {
         return 1;
     }
 
+    // the reverse star is only built (from the forward one) for the indegree
+    BidirectionalStarDigraph bi(vertex_count, edge_bag);
+
+    if (summary_mode) {
+        print_summary(std::cout, summarize(bi.forward()));
+        return 0;
+    }
+    if (!closure_file.empty()) {
+        return print_closure(std::cout, bi.forward(), closure_file, reaches_u,
+                             reaches_v);
+    }
+    if (reduce_mode) {
+        print_reduction(std::cout, bi.forward());
+        return 0;
+    }
+    if (critical_mode) {
+        try {
+            print_critical_path(std::cout, critical_path(bi.forward()));
+        } catch (const std::invalid_argument &e) {
+            std::cerr << "error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     std::cout << "----------------\n";
     // outdegree
     {
-        ForwardStarDigraph g(vertex_count, edge_bag);
+        ForwardStarDigraph &g = bi.forward();
         if (debug_mode) g.dbg(std::cerr);
         if (dot_mode) g.dot(std::cerr);
 
@@ -79,7 +209,7 @@ auto main(int argc, char **argv) -> int {
     std::cout << "----------------\n";
     // indegree
     {
-        ReverseStarDigraph g(vertex_count, edge_bag);
+        ReverseStarDigraph &g = bi.reverse();
         if (debug_mode) g.dbg(std::cerr);
         if (dot_mode) g.dot(std::cerr);
 
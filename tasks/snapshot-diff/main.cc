@@ -0,0 +1,107 @@
+#include <stdint.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "graph/diff.hh"
+#include "graph/star.hh"
+
+// Reads a graph in the usual input format (vertex count, edge count and then
+// each edge as an `orig dest` pair).
+auto read_graph(std::string_view file_name) -> ForwardStarDigraph {
+    std::ifstream input{std::string(file_name)};
+    if (!input.is_open()) {
+        throw std::runtime_error("failed to open file `" +
+                                 std::string(file_name) + "`");
+    }
+
+    uint32_t vertex_count = 0;
+    uint32_t edge_count   = 0;
+    input >> vertex_count >> edge_count;
+
+    EdgeBag edge_bag(edge_count);
+    uint32_t e_orig = 0;
+    uint32_t e_dest = 0;
+    while (input >> e_orig >> e_dest) {
+        edge_bag.add(Edge(e_orig, e_dest));
+    }
+    // sanity check
+    if (edge_bag.size() != edge_count) {
+        throw std::runtime_error("invalid edge count in `" +
+                                 std::string(file_name) + "`, expected " +
+                                 std::to_string(edge_count) + ", got " +
+                                 std::to_string(edge_bag.size()));
+    }
+    return {vertex_count, edge_bag};
+}
+
+// Writes a graph in the input format.
+void write_graph(std::ostream &sink, ForwardStarDigraph &g) {
+    size_t edge_count = 0;
+    for (const uint32_t v : g.vertexes()) edge_count += g.outdegree(v);
+    sink << g.vertexes_count() << " " << edge_count << "\n";
+    for (const uint32_t orig : g.vertexes()) {
+        for (const uint32_t dest : g.successors(orig)) {
+            sink << orig << " " << dest << "\n";
+        }
+    }
+}
+
+auto run_diff(std::string_view old_file, std::string_view new_file,
+              std::string_view delta_file) -> int {
+    ForwardStarDigraph old_g = read_graph(old_file);
+    ForwardStarDigraph new_g = read_graph(new_file);
+    const graph_delta delta  = diff(old_g, new_g);
+
+    std::ofstream output{std::string(delta_file), std::ios::binary};
+    if (!output.is_open()) {
+        std::cerr << "error: failed to open file `" << delta_file << "`\n";
+        return 1;
+    }
+    write_delta(output, delta);
+
+    std::cout << "vertexes: " << delta.old_vertexes << " -> "
+              << delta.new_vertexes << "\n";
+    std::cout << "added arcs: " << delta.added.arcs_count() << "\n";
+    std::cout << "removed arcs: " << delta.removed.arcs_count() << "\n";
+    std::cout << "delta size: " << output.tellp() << " bytes\n";
+    return 0;
+}
+
+auto run_apply(std::string_view old_file, std::string_view delta_file)
+    -> int {
+    ForwardStarDigraph old_g = read_graph(old_file);
+
+    std::ifstream input{std::string(delta_file), std::ios::binary};
+    if (!input.is_open()) {
+        std::cerr << "error: failed to open file `" << delta_file << "`\n";
+        return 1;
+    }
+    ForwardStarDigraph new_g = apply(old_g, read_delta(input));
+    write_graph(std::cout, new_g);
+    return 0;
+}
+
+auto main(int argc, char **argv) -> int {
+    const std::string_view mode(argc < 2 ? "" : argv[1]);
+    const bool is_diff  = mode == "diff" && argc == 5;
+    const bool is_apply = mode == "apply" && argc == 4;
+    if (!is_diff && !is_apply) {
+        std::cerr << "error: missing arguments\n";
+        std::cerr << "usage is: ./prog diff [old_file] [new_file] "
+                     "[delta_file]\n";
+        std::cerr << "      or: ./prog apply [old_file] [delta_file]\n";
+        return 1;
+    }
+
+    try {
+        if (is_diff) return run_diff(argv[2], argv[3], argv[4]);
+        return run_apply(argv[2], argv[3]);
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+}